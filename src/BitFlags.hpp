@@ -128,8 +128,8 @@ BIT_FLAGS_TEMPLATE void clear(TEnum what, TEnum& where)
 /// @returns True if at least one of the specified bits is set in the `target`, false otherwise.
 BIT_FLAGS_TEMPLATE bool isSet(TEnum what, TEnum& where, bool clear = false)
 {
-    if (!clear) return (where & what) != 0;
-    bool result = (where & what) != 0;
+    if (!clear) return (where & what) != TEnum();
+    bool result = (where & what) != TEnum();
     where &= ~what;
     return result;
 }
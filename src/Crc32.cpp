@@ -0,0 +1,32 @@
+/**
+ * @file        Crc32.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       CRC32 (IEEE 802.3) checksum. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Crc32.hpp"
+
+/// @brief CRC32 lookup table for the reflected 0xEDB88320 polynomial.
+static constexpr struct CrcTable { uint32_t items[256]; } crcTable = []
+{
+    CrcTable table = {};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit) value = value & 1 ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+        table.items[i] = value;
+    }
+    return table;
+}();
+
+uint32_t Crc32::update(uint32_t crc, const void *data, size_t length)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    while (length--) crc = crcTable.items[(crc ^ *p++) & 0xffu] ^ (crc >> 8);
+    return ~crc;
+}
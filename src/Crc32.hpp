@@ -0,0 +1,31 @@
+/**
+ * @file        Crc32.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       CRC32 (IEEE 802.3) checksum. Header file.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "StaticClass.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/// @brief CRC32 (IEEE 802.3, reflected 0xEDB88320 polynomial) calculated with a 256 entry lookup table.
+class Crc32 final
+{
+public:
+
+    STATIC(Crc32)
+
+    /// @brief Updates a CRC with the data, so the data can be checked in parts.
+    /// @param crc CRC of the previous data, 0 for the first part.
+    /// @param data Data pointer.
+    /// @param length Data length in bytes.
+    /// @returns Updated CRC.
+    static uint32_t update(uint32_t crc, const void* data, size_t length);
+
+};
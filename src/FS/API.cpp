@@ -11,11 +11,10 @@
 #include "Adapter.hpp"
 #include "API.hpp"
 #include "DateTime.hpp"
+#include "StatCache.hpp"
 #include <utility>
 #include <cstdarg>
 
-USE_ADAPTER
-
 static constexpr FS::AdapterTypes::Status ok = FS::AdapterTypes::OK;
 
 const FS::FileSystem* FS::internal()
@@ -30,14 +29,18 @@ bool FS::created(const FileSystem *fs, const char *path, DateTime &dateTime)
 {
     Path context(fs, path);
     if (!context.isValid()) return false;
-    return adapter.created(*context.fileSystem()->media(), context.relativePath(), dateTime) == ok;
+    return adapterOf(context.fileSystem()).created(context, dateTime) == ok;
 }
 
 bool FS::modified(const FileSystem *fs, const char *path, DateTime &dateTime)
 {
     Path context(fs, path);
     if (!context.isValid()) return false;
-    return adapter.modified(*context.fileSystem()->media(), context.relativePath(), dateTime) == ok;
+    AdapterTypes::Status status;
+    uint32_t generation = 0;
+    if (!StatCache::lookup(context, StatCache::modified, status, generation, &dateTime))
+        StatCache::store(context, StatCache::modified, generation, status = adapterOf(context.fileSystem()).modified(context, dateTime), &dateTime);
+    return status == ok;
 }
 
 bool FS::fileCreate(const FileSystem *fs, const char *path, ...)
@@ -47,7 +50,9 @@ bool FS::fileCreate(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.fileCreate(*context.fileSystem()->media(), context.relativePath()) == ok;
+    bool isDone = adapterOf(context.fileSystem()).fileCreate(context) == ok;
+    StatCache::invalidate(context);
+    return isDone;
 }
 
 bool FS::fileExists(const FileSystem *fs, const char *path, ...)
@@ -57,7 +62,11 @@ bool FS::fileExists(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.fileExists(*context.fileSystem()->media(), context.relativePath()) == ok;
+    AdapterTypes::Status status;
+    uint32_t generation = 0;
+    if (!StatCache::lookup(context, StatCache::fileExists, status, generation))
+        StatCache::store(context, StatCache::fileExists, generation, status = adapterOf(context.fileSystem()).fileExists(context));
+    return status == ok;
 }
 
 bool FS::fileRename(const FileSystem *fs, const char *oldName, const char *newName, ...)
@@ -70,7 +79,10 @@ bool FS::fileRename(const FileSystem *fs, const char *oldName, const char *newNa
     va_end(args2);
     va_end(args1);
     if (!n1.isValid() || !n2.isValid()) return false;
-    return adapter.fileRename(*n1.fileSystem()->media(), n1.relativePath(), n2.relativePath()) == ok;
+    bool isDone = adapterOf(n1.fileSystem()).fileRename(n1, n2) == ok;
+    StatCache::invalidate(n1);
+    StatCache::invalidate(n2);
+    return isDone;
 }
 
 bool FS::fileDelete(const FileSystem *fs, const char *path, ...)
@@ -80,7 +92,9 @@ bool FS::fileDelete(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.fileDelete(*context.fileSystem()->media(), context.relativePath()) == ok;
+    bool isDone = adapterOf(context.fileSystem()).fileDelete(context) == ok;
+    StatCache::invalidate(context);
+    return isDone;
 }
 
 bool FS::directoryCreate(const FileSystem *fs, const char *path, ...)
@@ -90,7 +104,9 @@ bool FS::directoryCreate(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.directoryCreate(*context.fileSystem()->media(), context.relativePath()) == ok;
+    bool isDone = adapterOf(context.fileSystem()).directoryCreate(context) == ok;
+    StatCache::invalidate(context);
+    return isDone;
 }
 
 bool FS::directoryExists(const FileSystem *fs, const char *path, ...)
@@ -100,7 +116,11 @@ bool FS::directoryExists(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.directoryExists(*context.fileSystem()->media(), context.relativePath()) == ok;
+    AdapterTypes::Status status;
+    uint32_t generation = 0;
+    if (!StatCache::lookup(context, StatCache::directoryExists, status, generation))
+        StatCache::store(context, StatCache::directoryExists, generation, status = adapterOf(context.fileSystem()).directoryExists(context));
+    return status == ok;
 }
 
 bool FS::directoryRename(const FileSystem *fs, const char *oldName, const char *newName, ...)
@@ -113,7 +133,9 @@ bool FS::directoryRename(const FileSystem *fs, const char *oldName, const char *
     va_end(args2);
     va_end(args1);
     if (!n1.isValid() || !n2.isValid()) return false;
-    return adapter.directoryRename(*n1.fileSystem()->media(), n1.relativePath(), n2.relativePath()) == ok;
+    bool isDone = adapterOf(n1.fileSystem()).directoryRename(n1, n2) == ok;
+    StatCache::flush(n1.fileSystem()->media()); // The paths of all entries inside are changed.
+    return isDone;
 }
 
 bool FS::directoryDelete(const FileSystem *fs, const char *path, ...)
@@ -123,5 +145,7 @@ bool FS::directoryDelete(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.directoryDelete(*context.fileSystem()->media(), context.relativePath()) == ok;
+    bool isDone = adapterOf(context.fileSystem()).directoryDelete(context) == ok;
+    StatCache::invalidate(context);
+    return isDone;
 }
@@ -10,9 +10,12 @@
 
 #pragma once
 
+#include "Copy.hpp"
 #include "DateTime.hpp"
+#include "Directory.hpp"
 #include "File.hpp"
 #include "Media.hpp"
+#include "RecordLog.hpp"
 
 namespace FS
 {
@@ -26,6 +29,9 @@ inline const FileSystem* SD() { return FileSystemTable::find(MediaType::SD); }
 /// @returns The USB disk file system pointer if it was mounted. Null pointer otherwise.
 inline const FileSystem* USB() { return FileSystemTable::find(MediaType::USB); }
 
+/// @returns The RAM disk file system pointer if it was mounted. Null pointer otherwise.
+inline const FileSystem* RAM() { return FileSystemTable::find(MediaType::RAM); }
+
 /// @returns The internal file system pointer if it was mounter. Null pointer otherwise.
 const FileSystem* internal();
 
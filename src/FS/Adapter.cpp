@@ -13,12 +13,6 @@
 namespace FS
 {
 
-#if defined(USE_FILEX)
-AdapterFILEX adapter;
-#elif defined(USE_FATFS)
-AdapterFATFS adapter;
-#else
-AdapterNull adapter;
-#endif
+DefaultAdapter adapter;
 
 }
@@ -13,11 +13,45 @@
 #include "target.h"
 #if defined(USE_FILEX)
 #include "AdapterFILEX.hpp"
-#define USE_ADAPTER static FS::AdapterFILEX adapter;
+namespace FS { using DefaultAdapter = AdapterFILEX; }
 #elif defined(USE_FATFS)
 #include "AdapterFATFS.hpp"
-#define USE_ADAPTER static FS::AdapterFATFS adapter;
+namespace FS { using DefaultAdapter = AdapterFATFS; }
+#elif defined(USE_POSIX)
+#include "AdapterPOSIX.hpp"
+namespace FS { using DefaultAdapter = AdapterPOSIX; }
+#elif defined(USE_RAMFS)
+#include "AdapterRAM.hpp"
+namespace FS { using DefaultAdapter = AdapterRAM; }
 #else
 #include "AdapterNull.hpp"
-#define USE_ADAPTER extern FS::AdapterNULL adapter;
+namespace FS { using DefaultAdapter = AdapterNull; }
 #endif
+
+#ifndef WTK_FS_ADAPTER_DISPATCH
+#define WTK_FS_ADAPTER_DISPATCH 0
+#endif
+
+namespace FS
+{
+
+extern DefaultAdapter adapter; // The compiled in backend adapter instance.
+
+#if WTK_FS_ADAPTER_DISPATCH
+
+/// @returns The adapter set for the file system entry when mounted, or the compiled in adapter.
+/// @param fs File system pointer.
+inline const IAdapterMethods& adapterOf(const FileSystem* fs)
+{
+    return fs && fs->adapter() ? *fs->adapter() : adapter;
+}
+
+#else
+
+/// @returns The compiled in adapter. Its type is final, so the calls are bound statically.
+/// @remarks The file system entries can't have own adapters in this configuration, `MediaServices::mount` rejects them.
+inline DefaultAdapter& adapterOf(const FileSystem*) { return adapter; }
+
+#endif
+
+}
@@ -17,56 +17,47 @@
 #include "datetime_fat.h"
 #include <cstring>
 
-FS::AdapterTypes::Status FS::AdapterFATFS::find(Media &media, const char *path, DirectoryEntry &entry) const
+FS::AdapterTypes::Status FS::AdapterFATFS::find(const Path &path, DirectoryEntry &entry) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context(fs, path);
     entry.dir = {};
     entry.info = {};
-    return f_findfirst(&entry.dir, &entry.info, context.absolutePath(), "*");
+    return f_findfirst(&entry.dir, &entry.info, path.absolutePath(), "*");
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::created(Media &media, const char *path, DateTime &dateTime) const
+FS::AdapterTypes::Status FS::AdapterFATFS::created(const Path &path, DateTime &dateTime) const
 {
     return FR_NOT_ENABLED;
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::modified(Media &media, const char *path, DateTime &dateTime) const
+FS::AdapterTypes::Status FS::AdapterFATFS::modified(const Path &path, DateTime &dateTime) const
 {
     FILINFO stat = {};
-    Status result = fstat(media, path, stat);
+    Status result = fstat(path, stat);
     if (result != OK) return result;
     toDateTime(stat.fdate, stat.ftime, dateTime);
     return result;
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::fileCreate(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFATFS::fileCreate(const Path &path) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context(fs, path);
     FileControlBlock file = {};
-    Status result = f_open(&file, context.absolutePath(), (BYTE)FileMode::createAlways);
+    Status result = f_open(&file, path.absolutePath(), (BYTE)FileMode::createAlways);
     if (result == OK) result = f_close(&file);
     return result;
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::fileExists(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFATFS::fileExists(const Path &path) const
 {
     FILINFO info = {};
-    Status result = fstat(media, path, info);
+    Status result = fstat(path, info);
     if (result != OK) return result;
     return (info.fattrib & AM_DIR) == 0 ? FR_OK : FR_EXIST;
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::fileOpen(Media &media, FileControlBlock &file, const char *path, FileMode mode) const
+FS::AdapterTypes::Status FS::AdapterFATFS::fileOpen(FileControlBlock &file, const Path &path, FileMode mode) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context(fs, path);
     file = {};
-    return f_open(&file, context.absolutePath(), (BYTE)mode);
+    return f_open(&file, path.absolutePath(), (BYTE)mode);
 }
 
 FS::AdapterTypes::Status FS::AdapterFATFS::fileSeek(FileControlBlock &file, FileOffset offset) const
@@ -74,6 +65,12 @@ FS::AdapterTypes::Status FS::AdapterFATFS::fileSeek(FileControlBlock &file, File
     return f_lseek(&file, offset);
 }
 
+FS::AdapterTypes::Status FS::AdapterFATFS::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    offset = f_tell(&file);
+    return OK;
+}
+
 FS::AdapterTypes::Status FS::AdapterFATFS::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
 {
     return f_read(&file, buffer, size, &bytesRead);
@@ -85,83 +82,118 @@ FS::AdapterTypes::Status FS::AdapterFATFS::fileWrite(FileControlBlock &file, con
     return f_write(&file, buffer, size, &bytesWritten);
 }
 
+FS::AdapterTypes::Status FS::AdapterFATFS::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    size = f_size(&file);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::fileExpand(FileControlBlock &file, FileOffset size, bool contiguous) const
+{
+    if (size <= f_size(&file)) return OK;
+#if !defined(_USE_EXPAND) || _USE_EXPAND == 1
+    if (contiguous) return f_expand(&file, size, 1); // Allocates a contiguous area for an empty file, sets its size.
+#else
+    if (contiguous) return FR_DENIED;
+#endif
+    FileOffset position = f_tell(&file);
+    Status result = f_lseek(&file, size); // Seeking past the end in write mode allocates the cluster chain.
+    if (result != FR_OK) return result;
+    return f_lseek(&file, position);
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::fileTruncate(FileControlBlock &file) const
+{
+    return f_truncate(&file);
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::fileSync(FileControlBlock &file) const
+{
+    return f_sync(&file);
+}
+
 FS::AdapterTypes::Status FS::AdapterFATFS::fileClose(FileControlBlock &file) const
 {
     return f_close(&file);
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::fileRename(Media &media, const char *oldName, const char *newName) const
+FS::AdapterTypes::Status FS::AdapterFATFS::fileRename(const Path &oldName, const Path &newName) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context1(fs, oldName);
-    Path context2(fs, newName);
     FILINFO stat = {};
-    Status result = f_stat(context1.absolutePath(), &stat);
+    Status result = f_stat(oldName.absolutePath(), &stat);
     if (result != OK) return result;
     if ((stat.fattrib & AM_DIR) != 0) return FR_DENIED; // Don't allow directory rename!
-    return f_rename(context1.absolutePath(), context2.absolutePath());
+    return f_rename(oldName.absolutePath(), newName.absolutePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::fileDelete(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFATFS::fileDelete(const Path &path) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context(fs, path);
     FILINFO stat = {};
-    Status result = f_stat(context.absolutePath(), &stat);
+    Status result = f_stat(path.absolutePath(), &stat);
     if (result != OK) return result;
     if ((stat.fattrib & AM_DIR) != 0) return FR_DENIED; // Don't allow directory delete!
-    return f_unlink(context.absolutePath());
+    return f_unlink(path.absolutePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::directoryCreate(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryCreate(const Path &path) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context(fs, path);
-    return f_mkdir(context.absolutePath());
+    return f_mkdir(path.absolutePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::directoryExists(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryExists(const Path &path) const
 {
     FILINFO stat = {};
-    Status result = fstat(media, path, stat);
+    Status result = fstat(path, stat);
     if (result != OK) return result;
     return (stat.fattrib & AM_DIR) != 0 ? FR_OK : FR_EXIST;
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::directoryRename(Media &media, const char *oldName, const char *newName) const
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryRename(const Path &oldName, const Path &newName) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context1(fs, oldName);
-    Path context2(fs, newName);
     FILINFO stat = {};
-    Status result = f_stat(context1.absolutePath(), &stat);
+    Status result = f_stat(oldName.absolutePath(), &stat);
     if (result != OK) return result;
     if ((stat.fattrib & AM_DIR) == 0) return FR_DENIED; // Don't allow file rename!
-    return f_rename(context1.absolutePath(), context2.absolutePath());
+    return f_rename(oldName.absolutePath(), newName.absolutePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::directoryDelete(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryDelete(const Path &path) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context(fs, path);
     FILINFO stat = {};
-    Status result = f_stat(context.absolutePath(), &stat);
+    Status result = f_stat(path.absolutePath(), &stat);
     if (result != OK) return result;
     if ((stat.fattrib & AM_DIR) == 0) return FR_DENIED; // Don't allow file delete!
-    return f_unlink(context.absolutePath());
+    return f_unlink(path.absolutePath());
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryOpen(DirectoryHandle &directory, const Path &path) const
+{
+    directory = {};
+    return f_opendir(&directory, path.absolutePath());
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryRead(DirectoryHandle &directory, EntryInfo &entry) const
+{
+    FILINFO info = {};
+    Status result = f_readdir(&directory, &info);
+    if (result != OK) return result;
+    std::strncpy(entry.name, info.fname, sizeof(entry.name) - 1);
+    entry.name[sizeof(entry.name) - 1] = 0;
+    entry.size = info.fsize;
+    entry.attributes = static_cast<EntryAttributes>(info.fattrib & (AM_RDO | AM_HID | AM_SYS | AM_DIR | AM_ARC));
+    entry.modified = DateTime();
+    if (entry.name[0]) toDateTime(info.fdate, info.ftime, entry.modified);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryClose(DirectoryHandle &directory) const
+{
+    return f_closedir(&directory);
 }
 
-FS::AdapterTypes::Status FS::AdapterFATFS::fstat(Media &media, const char *path, FILINFO &stat) const
+FS::AdapterTypes::Status FS::AdapterFATFS::fstat(const Path &path, FILINFO &stat) const
 {
-    auto fs = FileSystemTable::find(&media);
-    if (!fs) return FR_INVALID_DRIVE;
-    Path context(fs, path);
-    return f_stat(context.absolutePath(), &stat);
+    return f_stat(path.absolutePath(), &stat);
 }
 
 void FS::AdapterFATFS::toDateTime(WORD date, WORD time, DateTime &dateTime)
@@ -21,47 +21,49 @@ EXTERN_C_BEGIN
 EXTERN_C_END
 #include <cstring>
 
-FS::AdapterTypes::Status FS::AdapterFILEX::find(Media &media, const char *path, DirectoryEntry &entry) const
+FS::AdapterTypes::Status FS::AdapterFILEX::find(const Path &path, DirectoryEntry &entry) const
 {
+    Media& media = mediaOf(path);
     Status result = initializeEntry(media, entry); // The entry should be initialized first or the internal function call crash.
     if (result != OK) return result; // Entry initialization failed.
-    result = _fx_directory_search(&media, (CHAR*)path, &entry, nullptr, nullptr); // Now the result tells if we fetched the entry.
+    result = _fx_directory_search(&media, (CHAR*)path.relativePath(), &entry, nullptr, nullptr); // Now the result tells if we fetched the entry.
     return result;
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::created(Media &media, const char *path, DateTime &dateTime) const
+FS::AdapterTypes::Status FS::AdapterFILEX::created(const Path &path, DateTime &dateTime) const
 {
     DirectoryEntry entry = {};
-    Status result = find(media, path, entry);
+    Status result = find(path, entry);
     if (result != OK) return result;
     toDateTime(entry.fx_dir_entry_created_date, entry.fx_dir_entry_created_time, dateTime);
     return OK;
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::modified(Media &media, const char *path, DateTime &dateTime) const
+FS::AdapterTypes::Status FS::AdapterFILEX::modified(const Path &path, DateTime &dateTime) const
 {
     DirectoryEntry entry = {};
-    Status result = find(media, path, entry);
+    Status result = find(path, entry);
     if (result != OK) return result;
     toDateTime(entry.fx_dir_entry_date, entry.fx_dir_entry_time, dateTime);
     return OK;
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::fileCreate(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFILEX::fileCreate(const Path &path) const
 {
-    return fx_file_create(&media, (CHAR*)path);
+    return fx_file_create(&mediaOf(path), (CHAR*)path.relativePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::fileExists(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFILEX::fileExists(const Path &path) const
 {
     DirectoryEntry entry = {};
-    Status result = find(media, path, entry);
+    Status result = find(path, entry);
     if (result != OK) return result;
     return (entry.fx_dir_entry_attributes & (FX_VOLUME | FX_DIRECTORY)) == 0 ? FX_SUCCESS : FX_NOT_A_FILE;
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::fileOpen(Media &media, FileControlBlock &file, const char *path, FileMode mode) const
+FS::AdapterTypes::Status FS::AdapterFILEX::fileOpen(FileControlBlock &file, const Path &path, FileMode mode) const
 {
+    Media& media = mediaOf(path);
     UINT fxMode = 0;
     UINT fxStatus = FX_SUCCESS;
 
@@ -69,16 +71,16 @@ FS::AdapterTypes::Status FS::AdapterFILEX::fileOpen(Media &media, FileControlBlo
     else if (mode & write) fxMode = FX_OPEN_FOR_WRITE;
     if (mode & createNew)
     {
-        fxStatus = fx_file_create(&media, (CHAR*)path);
+        fxStatus = fx_file_create(&media, (CHAR*)path.relativePath());
         if (fxStatus == FX_ALREADY_CREATED) return fxStatus;
     }
     else if (mode & (createAlways | openAlways))
     {
-        fxStatus = fx_file_create(&media, (CHAR*)path);
+        fxStatus = fx_file_create(&media, (CHAR*)path.relativePath());
         if (fxStatus != OK && fxStatus != FX_ALREADY_CREATED) return fxStatus;
     }
 
-    fxStatus = fx_file_open(&media, &file, (CHAR*)path, fxMode);
+    fxStatus = fx_file_open(&media, &file, (CHAR*)path.relativePath(), fxMode);
     if (fxStatus != OK) return fxStatus;
 
     if (BF::isSet(FileMode::openAppend, mode)) fxStatus = fx_file_seek(&file, offsetMax);
@@ -91,6 +93,12 @@ FS::AdapterTypes::Status FS::AdapterFILEX::fileSeek(FileControlBlock &file, File
     return fx_file_seek(&file, offset);
 }
 
+FS::AdapterTypes::Status FS::AdapterFILEX::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    offset = static_cast<FileOffset>(file.fx_file_current_file_offset);
+    return OK;
+}
+
 FS::AdapterTypes::Status FS::AdapterFILEX::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
 {
     return fx_file_read(&file, buffer, size, (ULONG*)&bytesRead);
@@ -101,42 +109,113 @@ FS::AdapterTypes::Status FS::AdapterFILEX::fileWrite(FileControlBlock &file, con
     return fx_file_write(&file, const_cast<void*>(buffer), size);
 }
 
+FS::AdapterTypes::Status FS::AdapterFILEX::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    size = static_cast<FileOffset>(file.fx_file_current_file_size);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::fileExpand(FileControlBlock &file, FileOffset size, bool contiguous) const
+{
+    if (size <= file.fx_file_current_available_size) return OK;
+    ULONG missing = static_cast<ULONG>(size - file.fx_file_current_available_size);
+    if (contiguous) return fx_file_allocate(&file, missing); // Appends contiguous clusters, the file size is not changed.
+    ULONG allocated = 0;
+    Status result = fx_file_best_effort_allocate(&file, missing, &allocated);
+    if (result != FX_SUCCESS) return result;
+    return allocated >= missing ? FX_SUCCESS : FX_NO_MORE_SPACE;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::fileTruncate(FileControlBlock &file) const
+{
+    return fx_file_truncate_release(&file, file.fx_file_current_file_offset);
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::fileSync(FileControlBlock &file) const
+{
+    return fx_media_flush(file.fx_file_media_ptr); // FileX flushes the whole media, the directory entry included.
+}
+
 FS::AdapterTypes::Status FS::AdapterFILEX::fileClose(FileControlBlock &file) const
 {
     return fx_file_close(&file);
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::fileRename(Media &media, const char *oldName, const char *newName) const
+FS::AdapterTypes::Status FS::AdapterFILEX::fileRename(const Path &oldName, const Path &newName) const
 {
-    return fx_file_rename(&media, (CHAR*)oldName, (CHAR*)newName);
+    return fx_file_rename(&mediaOf(oldName), (CHAR*)oldName.relativePath(), (CHAR*)newName.relativePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::fileDelete(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFILEX::fileDelete(const Path &path) const
 {
-    return fx_file_delete(&media, (CHAR*)path);
+    return fx_file_delete(&mediaOf(path), (CHAR*)path.relativePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::directoryCreate(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryCreate(const Path &path) const
 {
-    return fx_directory_create(&media, (CHAR*)path);
+    return fx_directory_create(&mediaOf(path), (CHAR*)path.relativePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::directoryExists(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryExists(const Path &path) const
 {
     DirectoryEntry entry = {};
-    Status result = find(media, path, entry);
+    Status result = find(path, entry);
     if (result != OK) return false;
     return (entry.fx_dir_entry_attributes & FX_VOLUME) == 0 && (entry.fx_dir_entry_attributes & FX_DIRECTORY) != 0;
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::directoryRename(Media &media, const char *oldName, const char *newName) const
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryRename(const Path &oldName, const Path &newName) const
 {
-    return fx_directory_rename(&media, (CHAR*)oldName, (CHAR*)newName);
+    return fx_directory_rename(&mediaOf(oldName), (CHAR*)oldName.relativePath(), (CHAR*)newName.relativePath());
 }
 
-FS::AdapterTypes::Status FS::AdapterFILEX::directoryDelete(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryDelete(const Path &path) const
 {
-    return fx_directory_delete(&media, (CHAR*)path);
+    return fx_directory_delete(&mediaOf(path), (CHAR*)path.relativePath());
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryOpen(DirectoryHandle &directory, const Path &path) const
+{
+    Media& media = mediaOf(path);
+    directory = {};
+    const char* relative = path.relativePath();
+    Status result = fx_directory_local_path_set(&media, &directory.path, (CHAR*)(*relative ? relative : "/"));
+    if (result != OK) return result;
+    fx_directory_local_path_clear(&media); // The path is restored per read, other relative paths must not resolve inside it.
+    directory.media = &media;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryRead(DirectoryHandle &directory, EntryInfo &entry) const
+{
+    if (!directory.media) return FX_PTR_ERROR;
+    Status result = fx_directory_local_path_restore(directory.media, &directory.path); // Another directory could be enumerated meanwhile.
+    if (result != OK) return result;
+    UINT attributes = 0, year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    ULONG size = 0;
+    result = directory.isStarted
+        ? fx_directory_next_full_entry_find(directory.media, entry.name, &attributes, &size, &year, &month, &day, &hour, &minute, &second)
+        : fx_directory_first_full_entry_find(directory.media, entry.name, &attributes, &size, &year, &month, &day, &hour, &minute, &second);
+    directory.isStarted = 1;
+    fx_directory_local_path_clear(directory.media); // Other relative paths must not resolve inside the listed directory.
+    if (result == FX_NO_MORE_ENTRIES)
+    {
+        entry = {};
+        return OK;
+    }
+    if (result != OK) return result;
+    entry.size = size;
+    entry.attributes = static_cast<EntryAttributes>(attributes & (FX_READ_ONLY | FX_HIDDEN | FX_SYSTEM | FX_DIRECTORY | FX_ARCHIVE));
+    entry.modified = DateTime(year, month, day, hour, minute, second);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryClose(DirectoryHandle &directory) const
+{
+    if (!directory.media) return FX_PTR_ERROR;
+    Status result = fx_directory_local_path_clear(directory.media);
+    directory = {};
+    return result;
 }
 
 FS::AdapterTypes::Status FS::AdapterFILEX::initializeEntry(Media &media, DirectoryEntry &entry)
@@ -13,37 +13,37 @@
 
 #include "target.h"
 
-#if !defined(USE_FILEX) && !defined(USE_FATFS)
+#if !defined(USE_FILEX) && !defined(USE_FATFS) && !defined(USE_POSIX) && !defined(USE_RAMFS)
 
 #include "AdapterNull.hpp"
 #include "BitFlags.hpp"
 
-FS::AdapterTypes::Status FS::AdapterNull::find(Media &media, const char *path, DirectoryEntry &entry) const
+FS::AdapterTypes::Status FS::AdapterNull::find(const Path &path, DirectoryEntry &entry) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::created(Media &media, const char *path, DateTime &dateTime) const
+FS::AdapterTypes::Status FS::AdapterNull::created(const Path &path, DateTime &dateTime) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::modified(Media &media, const char *path, DateTime &dateTime) const
+FS::AdapterTypes::Status FS::AdapterNull::modified(const Path &path, DateTime &dateTime) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::fileCreate(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterNull::fileCreate(const Path &path) const
 {
     return OK;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::fileExists(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterNull::fileExists(const Path &path) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::fileOpen(Media &media, FileControlBlock &file, const char *path, FileMode mode) const
+FS::AdapterTypes::Status FS::AdapterNull::fileOpen(FileControlBlock &file, const Path &path, FileMode mode) const
 {
     if (!BF::isSet(FileMode::write, mode) || file.isUsed) return FS_NEGATIVE;
     file.isUsed = true;
@@ -55,6 +55,12 @@ FS::AdapterTypes::Status FS::AdapterNull::fileSeek(FileControlBlock &file, FileO
     return file.isUsed ? OK : FS_NEGATIVE;
 }
 
+FS::AdapterTypes::Status FS::AdapterNull::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    offset = 0;
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
 FS::AdapterTypes::Status FS::AdapterNull::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
 {
     return FS_NEGATIVE;
@@ -66,6 +72,27 @@ FS::AdapterTypes::Status FS::AdapterNull::fileWrite(FileControlBlock &file, cons
     return OK;
 }
 
+FS::AdapterTypes::Status FS::AdapterNull::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    size = 0;
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::fileExpand(FileControlBlock &file, FileOffset, bool) const
+{
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::fileTruncate(FileControlBlock &file) const
+{
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::fileSync(FileControlBlock &file) const
+{
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
 FS::AdapterTypes::Status FS::AdapterNull::fileClose(FileControlBlock &file) const
 {
     if (!file.isUsed) return FS_NEGATIVE;
@@ -73,32 +100,47 @@ FS::AdapterTypes::Status FS::AdapterNull::fileClose(FileControlBlock &file) cons
     return OK;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::fileRename(Media &media, const char *oldName, const char *newName) const
+FS::AdapterTypes::Status FS::AdapterNull::fileRename(const Path &oldName, const Path &newName) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::fileDelete(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterNull::fileDelete(const Path &path) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::directoryCreate(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterNull::directoryCreate(const Path &path) const
 {
     return OK;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::directoryExists(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterNull::directoryExists(const Path &path) const
+{
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::directoryRename(const Path &oldName, const Path &newName) const
+{
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::directoryDelete(const Path &path) const
+{
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::directoryOpen(DirectoryHandle &directory, const Path &path) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::directoryRename(Media &media, const char *oldName, const char *newName) const
+FS::AdapterTypes::Status FS::AdapterNull::directoryRead(DirectoryHandle &directory, EntryInfo &entry) const
 {
     return FS_NEGATIVE;
 }
 
-FS::AdapterTypes::Status FS::AdapterNull::directoryDelete(Media &media, const char *path) const
+FS::AdapterTypes::Status FS::AdapterNull::directoryClose(DirectoryHandle &directory) const
 {
     return FS_NEGATIVE;
 }
@@ -15,7 +15,7 @@
 
 #include "target.h"
 
-#if !defined(USE_FILEX) && !defined(USE_FATFS)
+#if !defined(USE_FILEX) && !defined(USE_FATFS) && !defined(USE_POSIX) && !defined(USE_RAMFS)
 
 #include "IAdapterMethods.hpp"
 
@@ -31,45 +31,39 @@ class AdapterNull final : public IAdapterMethods
 public:
 
     /// @brief Finds the directory entry that matches the path.
-    /// @param media Media structure reference.
     /// @param path File or directory path.
     /// @param entry Directory entry reference.
     /// @returns Status.
-    Status find(Media& media, const char* path, DirectoryEntry& entry) const override;
+    Status find(const Path& path, DirectoryEntry& entry) const override;
 
     /// @brief Gets the file or directory creation time.
-    /// @param media Media structure reference.
     /// @param path File or directory path.
     /// @param dateTime `DateTime` structure reference.
     /// @returns Status.
-    Status created(Media& media, const char* path, DateTime& dateTime) const override;
+    Status created(const Path& path, DateTime& dateTime) const override;
 
     /// @brief Gets the file or directory last modification time.
-    /// @param media Media structure reference.
     /// @param path File or directory path.
     /// @param dateTime `DateTime` structure reference.
     /// @returns Status.
-    Status modified(Media& media, const char* path, DateTime& dateTime) const override;
+    Status modified(const Path& path, DateTime& dateTime) const override;
 
     /// @brief Creates a file.
-    /// @param media Media structure reference.
     /// @param path File path.
     /// @returns Status.
-    Status fileCreate(Media& media, const char* path) const override;
+    Status fileCreate(const Path& path) const override;
 
     /// @brief Tests if a file exist on the media.
-    /// @param media Media structure reference.
     /// @param path File path.
     /// @returns True if the file exists, false otherwise.
-    Status fileExists(Media& media, const char* path) const override;
+    Status fileExists(const Path& path) const override;
 
     /// @brief Opens a file.
-    /// @param media Media structure reference.
     /// @param file File handle reference.
     /// @param path A path to the file relative to the file system root.
     /// @param mode File opening mode. Default opens existing file for reading.
     /// @returns Status.
-    Status fileOpen(Media& media, FileControlBlock& file, const char* path, FileMode mode = FileMode::read) const override;
+    Status fileOpen(FileControlBlock& file, const Path& path, FileMode mode = FileMode::read) const override;
 
     /// @brief Moves the file pointer to the specified offset.
     /// @param file File handle reference.
@@ -77,6 +71,12 @@ public:
     /// @returns Status.
     Status fileSeek(FileControlBlock& file, FileOffset offset) const override;
 
+    /// @brief Gets the current file pointer.
+    /// @param file File handle reference.
+    /// @param offset Position within the file variable reference.
+    /// @returns Status.
+    Status fileTell(FileControlBlock& file, FileOffset& offset) const override;
+
     /// @brief Reads data from a file.
     /// @param file File handle reference.
     /// @param buffer Buffer pointer.
@@ -93,48 +93,82 @@ public:
     /// @returns Status.
     Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const override;
 
+    /// @brief Gets the current file size, including the data not synced yet.
+    /// @param file File handle reference.
+    /// @param size File size variable reference.
+    /// @returns Status.
+    Status fileSize(FileControlBlock& file, FileOffset& size) const override;
+
+    /// @brief Reserves the media space for the file data, so the following writes don't allocate it.
+    /// @param file File handle reference.
+    /// @param size The file size in bytes to reserve the space for.
+    /// @param contiguous True to require a single contiguous area.
+    /// @returns Status.
+    Status fileExpand(FileControlBlock& file, FileOffset size, bool contiguous) const override;
+
+    /// @brief Truncates the file at the current file pointer, releasing the space reserved past it.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileTruncate(FileControlBlock& file) const override;
+
+    /// @brief Writes the cached file data and the directory entry to the media.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileSync(FileControlBlock& file) const override;
+
     /// @brief Closes a file.
     /// @param file File handle reference.
     /// @returns Status.
     Status fileClose(FileControlBlock& file) const override;
 
     /// @brief Renames a file.
-    /// @param media Media structure reference.
     /// @param oldName Old file name.
     /// @param newName New file name.
     /// @returns Status.
-    Status fileRename(Media& media, const char* oldName, const char* newName) const override;
+    Status fileRename(const Path& oldName, const Path& newName) const override;
 
     /// @brief Deletes a file.
-    /// @param media Media structure reference.
     /// @param path File name.
     /// @returns Status.
-    Status fileDelete(Media& media, const char* path) const override;
+    Status fileDelete(const Path& path) const override;
 
     /// @brief Creates a directory on the media.
-    /// @param media Media structure reference.
     /// @param path Directory name.
     /// @returns Status.
-    Status directoryCreate(Media& media, const char* path) const override;
+    Status directoryCreate(const Path& path) const override;
 
     /// @brief Tests if a directory exists on the media.
-    /// @param media Media structure reference.
     /// @param path Directory name.
     /// @returns Status.
-    Status directoryExists(Media& media, const char* path) const override;
+    Status directoryExists(const Path& path) const override;
 
     /// @brief Renames a directory on the media.
-    /// @param media Media structure reference.
     /// @param oldName Old directory name.
     /// @param newName New directory name.
     /// @returns Status.
-    Status directoryRename(Media& media, const char* oldName, const char* newName) const override;
+    Status directoryRename(const Path& oldName, const Path& newName) const override;
 
     /// @brief Deletes a directory from the media.
-    /// @param media Media structure reference.
     /// @param path Directory name.
     /// @returns Status.
-    Status directoryDelete(Media& media, const char* path) const override;
+    Status directoryDelete(const Path& path) const override;
+
+    /// @brief Opens a directory for the entry enumeration.
+    /// @param directory Directory handle reference.
+    /// @param path Directory path, can be the file system root.
+    /// @returns Status.
+    Status directoryOpen(DirectoryHandle& directory, const Path& path) const override;
+
+    /// @brief Reads the next directory entry.
+    /// @param directory Directory handle reference.
+    /// @param entry Entry information reference. The name is set empty at the end of the directory.
+    /// @returns Status.
+    Status directoryRead(DirectoryHandle& directory, EntryInfo& entry) const override;
+
+    /// @brief Closes the directory handle.
+    /// @param directory Directory handle reference.
+    /// @returns Status.
+    Status directoryClose(DirectoryHandle& directory) const override;
 
 };
 
@@ -0,0 +1,364 @@
+/**
+ * @file        AdapterPOSIX.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File system adapter for the host POSIX file API. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "target.h"
+
+#ifdef USE_POSIX
+
+#include "AdapterPOSIX.hpp"
+#include "BitFlags.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::find(const Path &path, DirectoryEntry &entry) const
+{
+    struct stat info = {};
+    Status result = hostStat(path, info);
+    if (result != OK) return result;
+    entry = {};
+    const char* name = std::strrchr(path.relativePath(), '/');
+    std::snprintf(entry.name, sizeof(entry.name), "%s", name ? name + 1 : path.relativePath());
+    entry.size = static_cast<uint64_t>(info.st_size);
+    entry.modified = static_cast<int64_t>(info.st_mtime);
+    entry.isDirectory = S_ISDIR(info.st_mode) ? 1 : 0;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::created(const Path &, DateTime &) const
+{
+    return ENOTSUP; // POSIX `stat` doesn't provide the creation time.
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::modified(const Path &path, DateTime &dateTime) const
+{
+    struct stat info = {};
+    Status result = hostStat(path, info);
+    if (result != OK) return result;
+    dateTime = DateTime(info.st_mtime);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileCreate(const Path &path) const
+{
+    char host[hostPathLength];
+    Status result = hostPath(path, host);
+    if (result != OK) return result;
+    int descriptor = ::open(host, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) return lastError();
+    return ::close(descriptor) == 0 ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileExists(const Path &path) const
+{
+    struct stat info = {};
+    Status result = hostStat(path, info);
+    if (result != OK) return result;
+    return S_ISREG(info.st_mode) ? OK : EISDIR;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileOpen(FileControlBlock &file, const Path &path, FileMode mode) const
+{
+    char host[hostPathLength];
+    Status result = hostPath(path, host);
+    if (result != OK) return result;
+    bool read = BF::isSet(FileMode::read, mode), write = BF::isSet(FileMode::write, mode);
+    int flags = read && write ? O_RDWR : write ? O_WRONLY : O_RDONLY;
+    if (BF::isSet(FileMode::createNew, mode)) flags |= O_CREAT | O_EXCL;
+    else if (BF::isSet(FileMode::createAlways, mode)) flags |= O_CREAT | O_TRUNC;
+    else if (BF::isSet(FileMode::openAlways, mode)) flags |= O_CREAT;
+    file = {};
+    int descriptor = ::open(host, flags, 0644);
+    if (descriptor < 0) return lastError();
+    file.isUsed = 1;
+    file.descriptor = descriptor;
+    if ((mode & FileMode::openAppend) == FileMode::openAppend)
+    {
+        result = fileSeek(file, offsetMax);
+        if (result != OK) // The handle is not returned, so it must not stay open.
+        {
+            ::close(descriptor);
+            file = {};
+        }
+        return result;
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileSeek(FileControlBlock &file, FileOffset offset) const
+{
+    if (!file.isUsed) return EBADF;
+    if (offset == offsetMax) // Seek to the end of the file.
+    {
+        struct stat info = {};
+        if (::fstat(file.descriptor, &info) != 0) return lastError();
+        offset = static_cast<FileOffset>(info.st_size);
+    }
+    file.offset = offset;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    if (!file.isUsed) return EBADF;
+    offset = file.offset;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
+{
+    bytesRead = 0;
+    if (!file.isUsed) return EBADF;
+    if (latency) ::usleep(latency);
+    auto target = static_cast<uint8_t*>(buffer);
+    while (bytesRead < size)
+    {
+        ssize_t n = ::pread(file.descriptor, target + bytesRead, size - bytesRead, static_cast<off_t>(file.offset));
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            return lastError();
+        }
+        if (n == 0) break; // End of file.
+        bytesRead += static_cast<size_t>(n);
+        file.offset += static_cast<FileOffset>(n);
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileWrite(FileControlBlock &file, const void *buffer, size_t size) const
+{
+    if (!file.isUsed) return EBADF;
+    if (latency) ::usleep(latency);
+    auto source = static_cast<const uint8_t*>(buffer);
+    size_t bytesWritten = 0;
+    while (bytesWritten < size)
+    {
+        ssize_t n = ::pwrite(file.descriptor, source + bytesWritten, size - bytesWritten, static_cast<off_t>(file.offset));
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            return lastError();
+        }
+        if (n == 0) return ENOSPC; // No progress, the media is full.
+        bytesWritten += static_cast<size_t>(n);
+        file.offset += static_cast<FileOffset>(n);
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileReadv(FileControlBlock &file, const IOVector *vectors, size_t count, size_t &bytesRead) const
+{
+    bytesRead = 0;
+    if (!file.isUsed) return EBADF;
+    if (latency) ::usleep(latency);
+    struct iovec host[maxVectors];
+    size_t first = 0, skip = 0; // The first buffer not filled and the number of bytes already read into it.
+    while (first < count)
+    {
+        size_t n = 0;
+        for (size_t i = first; i < count && n < maxVectors; ++i, ++n)
+            host[n] = { static_cast<uint8_t*>(vectors[i].data) + (i == first ? skip : 0), vectors[i].size - (i == first ? skip : 0) };
+        ssize_t length = ::preadv(file.descriptor, host, static_cast<int>(n), static_cast<off_t>(file.offset));
+        if (length < 0)
+        {
+            if (errno == EINTR) continue;
+            return lastError();
+        }
+        if (length == 0) break; // End of file.
+        bytesRead += static_cast<size_t>(length);
+        file.offset += static_cast<FileOffset>(length);
+        for (skip += static_cast<size_t>(length); first < count && skip >= vectors[first].size; ++first) skip -= vectors[first].size;
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileWritev(FileControlBlock &file, const IOVector *vectors, size_t count) const
+{
+    if (!file.isUsed) return EBADF;
+    if (latency) ::usleep(latency);
+    struct iovec host[maxVectors];
+    size_t first = 0, skip = 0; // The first buffer not written and the number of bytes already written from it.
+    while (first < count)
+    {
+        size_t n = 0;
+        for (size_t i = first; i < count && n < maxVectors; ++i, ++n)
+            host[n] = { static_cast<uint8_t*>(vectors[i].data) + (i == first ? skip : 0), vectors[i].size - (i == first ? skip : 0) };
+        ssize_t length = ::pwritev(file.descriptor, host, static_cast<int>(n), static_cast<off_t>(file.offset));
+        if (length < 0)
+        {
+            if (errno == EINTR) continue;
+            return lastError();
+        }
+        if (length == 0 && vectors[first].size > skip) return ENOSPC; // No progress, the media is full.
+        file.offset += static_cast<FileOffset>(length);
+        for (skip += static_cast<size_t>(length); first < count && skip >= vectors[first].size; ++first) skip -= vectors[first].size;
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    if (!file.isUsed) return EBADF;
+    struct stat info = {};
+    if (::fstat(file.descriptor, &info) != 0) return lastError();
+    size = static_cast<FileOffset>(info.st_size);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileExpand(FileControlBlock &file, FileOffset size, bool) const
+{
+    if (!file.isUsed) return EBADF;
+#ifdef FALLOC_FL_KEEP_SIZE
+    if (::fallocate(file.descriptor, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) == 0) return OK; // Contiguity is up to the host.
+    if (errno != EOPNOTSUPP) return lastError();
+#endif
+    return ::posix_fallocate(file.descriptor, 0, static_cast<off_t>(size)); // Returns the error number, sets the size.
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileTruncate(FileControlBlock &file) const
+{
+    if (!file.isUsed) return EBADF;
+    return ::ftruncate(file.descriptor, static_cast<off_t>(file.offset)) == 0 ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileSync(FileControlBlock &file) const
+{
+    if (!file.isUsed) return EBADF;
+    return ::fsync(file.descriptor) == 0 ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileClose(FileControlBlock &file) const
+{
+    if (!file.isUsed) return EBADF;
+    Status result = ::close(file.descriptor) == 0 ? OK : lastError();
+    file = {};
+    return result;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileRename(const Path &oldName, const Path &newName) const
+{
+    char host1[hostPathLength], host2[hostPathLength];
+    Status result = hostPath(oldName, host1);
+    if (result == OK) result = hostPath(newName, host2);
+    if (result != OK) return result;
+    struct stat info = {};
+    if (::stat(host1, &info) != 0) return lastError();
+    if (S_ISDIR(info.st_mode)) return EISDIR; // Don't allow directory rename!
+    return ::rename(host1, host2) == 0 ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileDelete(const Path &path) const
+{
+    char host[hostPathLength];
+    Status result = hostPath(path, host);
+    if (result != OK) return result;
+    return ::unlink(host) == 0 ? OK : lastError(); // `unlink` refuses directories.
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryCreate(const Path &path) const
+{
+    char host[hostPathLength];
+    Status result = hostPath(path, host);
+    if (result != OK) return result;
+    return ::mkdir(host, 0755) == 0 ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryExists(const Path &path) const
+{
+    struct stat info = {};
+    Status result = hostStat(path, info);
+    if (result != OK) return result;
+    return S_ISDIR(info.st_mode) ? OK : ENOTDIR;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryRename(const Path &oldName, const Path &newName) const
+{
+    char host1[hostPathLength], host2[hostPathLength];
+    Status result = hostPath(oldName, host1);
+    if (result == OK) result = hostPath(newName, host2);
+    if (result != OK) return result;
+    struct stat info = {};
+    if (::stat(host1, &info) != 0) return lastError();
+    if (!S_ISDIR(info.st_mode)) return ENOTDIR; // Don't allow file rename!
+    return ::rename(host1, host2) == 0 ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryDelete(const Path &path) const
+{
+    char host[hostPathLength];
+    Status result = hostPath(path, host);
+    if (result != OK) return result;
+    return ::rmdir(host) == 0 ? OK : lastError(); // `rmdir` refuses files.
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryOpen(DirectoryHandle &directory, const Path &path) const
+{
+    char host[hostPathLength];
+    Status result = hostPath(path, host);
+    if (result != OK) return result;
+    directory.stream = ::opendir(host);
+    return directory.stream ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryRead(DirectoryHandle &directory, EntryInfo &entry) const
+{
+    if (!directory.stream) return EBADF;
+    entry = {};
+    errno = 0;
+    struct dirent* item = ::readdir(directory.stream);
+    if (!item) return errno ? lastError() : OK; // The end of the directory leaves the name empty.
+    std::snprintf(entry.name, sizeof(entry.name), "%s", item->d_name);
+    struct stat info = {};
+    if (::fstatat(::dirfd(directory.stream), item->d_name, &info, 0) != 0) return lastError();
+    entry.size = S_ISREG(info.st_mode) ? static_cast<uint64_t>(info.st_size) : 0;
+    entry.modified = DateTime(info.st_mtime);
+    if (S_ISDIR(info.st_mode)) entry.attributes |= EntryAttributes::directory;
+    if (!(info.st_mode & S_IWUSR)) entry.attributes |= EntryAttributes::readOnly;
+    if (item->d_name[0] == '.') entry.attributes |= EntryAttributes::hidden;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryClose(DirectoryHandle &directory) const
+{
+    if (!directory.stream) return EBADF;
+    Status result = ::closedir(directory.stream) == 0 ? OK : lastError();
+    directory.stream = nullptr;
+    return result;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::hostPath(const Path &path, char *buffer)
+{
+    if (!path.fileSystem()) return ENODEV;
+    auto configuration = MediaServices::getConfiguration(path.fileSystem()->root());
+    if (!configuration || !configuration->driver) return ENODEV;
+    const char* relative = path.relativePath();
+    while (*relative == '/') ++relative;
+    int length = std::snprintf(buffer, hostPathLength, "%s/%s", configuration->driver, relative);
+    return length >= 0 && static_cast<size_t>(length) < hostPathLength ? OK : ENAMETOOLONG;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::hostStat(const Path &path, struct stat &info)
+{
+    char host[hostPathLength];
+    Status result = hostPath(path, host);
+    if (result != OK) return result;
+    return ::stat(host, &info) == 0 ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::lastError(void)
+{
+    return errno ? errno : FS_ERROR;
+}
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file        AdapterPOSIX.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File system adapter for the host POSIX file API. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+
+#ifdef USE_POSIX
+
+#include "IAdapterMethods.hpp"
+#include <sys/stat.h>
+
+#ifndef WTK_FS_POSIX_LATENCY
+#define WTK_FS_POSIX_LATENCY 0
+#endif
+
+namespace FS
+{
+
+/// @brief A unified file system access API for the host POSIX file API.
+/// @remarks Each mounted file system root is mapped onto a host directory, registered as the media driver:
+///          `MediaServices::registerType(MediaType::SD, "0:/", "/tmp/sd")`. The media structure is not used.
+///          Statuses are `errno` values. Files are accessed with `pread` and `pwrite` at the handle offset.
+///          `WTK_FS_POSIX_LATENCY` adds a delay to each file read and write call to simulate a slow media.
+class AdapterPOSIX final : public IAdapterMethods
+{
+
+public:
+
+    /// @brief Finds the directory entry that matches the path.
+    /// @param path File or directory path.
+    /// @param entry Directory entry reference.
+    /// @returns Status.
+    Status find(const Path& path, DirectoryEntry& entry) const override;
+
+    /// @brief Gets the file or directory creation time.
+    /// @param path File or directory path.
+    /// @param dateTime `DateTime` structure reference.
+    /// @returns Status.
+    Status created(const Path& path, DateTime& dateTime) const override;
+
+    /// @brief Gets the file or directory last modification time.
+    /// @param path File or directory path.
+    /// @param dateTime `DateTime` structure reference.
+    /// @returns Status.
+    Status modified(const Path& path, DateTime& dateTime) const override;
+
+    /// @brief Creates a file.
+    /// @param path File path.
+    /// @returns Status.
+    Status fileCreate(const Path& path) const override;
+
+    /// @brief Tests if a file exist on the media.
+    /// @param path File path.
+    /// @returns True if the file exists, false otherwise.
+    Status fileExists(const Path& path) const override;
+
+    /// @brief Opens a file.
+    /// @param file File handle reference.
+    /// @param path A path to the file relative to the file system root.
+    /// @param mode File opening mode. Default opens existing file for reading.
+    /// @returns Status.
+    Status fileOpen(FileControlBlock& file, const Path& path, FileMode mode = FileMode::read) const override;
+
+    /// @brief Moves the file pointer to the specified offset.
+    /// @param file File handle reference.
+    /// @param offset Position within the file.
+    /// @returns Status.
+    Status fileSeek(FileControlBlock& file, FileOffset offset) const override;
+
+    /// @brief Gets the current file pointer.
+    /// @param file File handle reference.
+    /// @param offset Position within the file variable reference.
+    /// @returns Status.
+    Status fileTell(FileControlBlock& file, FileOffset& offset) const override;
+
+    /// @brief Reads data from a file.
+    /// @param file File handle reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size.
+    /// @param bytesRead Number of bytes read variable reference.
+    /// @returns Status.
+    Status fileRead(FileControlBlock& file, void* buffer, size_t size, size_t& bytesRead) const override;
+
+    /// @brief Writes data to a file.
+    /// @param file File handle reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size.
+    /// @returns Status.
+    Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const override;
+
+    /// @brief Reads data from a file into consecutive buffers with one `preadv` call per `maxVectors` buffers.
+    /// @param file File handle reference.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @param bytesRead Number of bytes read variable reference.
+    /// @returns Status.
+    Status fileReadv(FileControlBlock& file, const IOVector* vectors, size_t count, size_t& bytesRead) const override;
+
+    /// @brief Writes data from consecutive buffers to a file with one `pwritev` call per `maxVectors` buffers.
+    /// @param file File handle reference.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @returns Status.
+    Status fileWritev(FileControlBlock& file, const IOVector* vectors, size_t count) const override;
+
+    /// @brief Gets the current file size, including the data not synced yet.
+    /// @param file File handle reference.
+    /// @param size File size variable reference.
+    /// @returns Status.
+    Status fileSize(FileControlBlock& file, FileOffset& size) const override;
+
+    /// @brief Reserves the media space for the file data, so the following writes don't allocate it.
+    /// @param file File handle reference.
+    /// @param size The file size in bytes to reserve the space for.
+    /// @param contiguous True to require a single contiguous area.
+    /// @returns Status.
+    Status fileExpand(FileControlBlock& file, FileOffset size, bool contiguous) const override;
+
+    /// @brief Truncates the file at the current file pointer, releasing the space reserved past it.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileTruncate(FileControlBlock& file) const override;
+
+    /// @brief Writes the cached file data and the directory entry to the media.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileSync(FileControlBlock& file) const override;
+
+    /// @brief Closes a file.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileClose(FileControlBlock& file) const override;
+
+    /// @brief Renames a file.
+    /// @param oldName Old file name.
+    /// @param newName New file name.
+    /// @returns Status.
+    Status fileRename(const Path& oldName, const Path& newName) const override;
+
+    /// @brief Deletes a file.
+    /// @param path File name.
+    /// @returns Status.
+    Status fileDelete(const Path& path) const override;
+
+    /// @brief Creates a directory on the media.
+    /// @param path Directory name.
+    /// @returns Status.
+    Status directoryCreate(const Path& path) const override;
+
+    /// @brief Tests if a directory exists on the media.
+    /// @param path Directory name.
+    /// @returns Status.
+    Status directoryExists(const Path& path) const override;
+
+    /// @brief Renames a directory on the media.
+    /// @param oldName Old directory name.
+    /// @param newName New directory name.
+    /// @returns Status.
+    Status directoryRename(const Path& oldName, const Path& newName) const override;
+
+    /// @brief Deletes a directory from the media.
+    /// @param path Directory name.
+    /// @returns Status code.
+    Status directoryDelete(const Path& path) const override;
+
+    /// @brief Opens a directory for the entry enumeration.
+    /// @param directory Directory handle reference.
+    /// @param path Directory path, can be the file system root.
+    /// @returns Status code.
+    Status directoryOpen(DirectoryHandle& directory, const Path& path) const override;
+
+    /// @brief Reads the next directory entry.
+    /// @param directory Directory handle reference.
+    /// @param entry Entry information reference. The name is set empty at the end of the directory.
+    /// @returns Status code.
+    Status directoryRead(DirectoryHandle& directory, EntryInfo& entry) const override;
+
+    /// @brief Closes the directory handle.
+    /// @param directory Directory handle reference.
+    /// @returns Status code.
+    Status directoryClose(DirectoryHandle& directory) const override;
+
+private:
+
+    static constexpr size_t hostPathLength = 512; // Host path buffer size.
+    static constexpr size_t maxVectors = 16; // The maximal number of buffers passed to one `preadv` or `pwritev` call.
+    static constexpr unsigned latency = WTK_FS_POSIX_LATENCY; // Simulated media latency in microseconds per read or write call.
+
+    /// @brief Builds the host path of the file system entry.
+    /// @param path File or directory path.
+    /// @param buffer Target buffer of `hostPathLength` bytes.
+    /// @returns Status.
+    static Status hostPath(const Path& path, char* buffer);
+
+    /// @brief Gets the host file status.
+    /// @param path File or directory path.
+    /// @param info Host status reference.
+    /// @returns Status.
+    static Status hostStat(const Path& path, struct stat& info);
+
+    /// @returns The current `errno` value as the status, `FS_ERROR` if not set.
+    static Status lastError(void);
+
+};
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file        AdapterProxy.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File system adapter forwarding all calls to another adapter. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "IAdapterMethods.hpp"
+
+namespace FS
+{
+
+/// @brief Forwards all adapter calls to the inner adapter.
+/// @remarks A base for the tracing, caching or encrypting layers mounted with `MediaServices::mount(media, root, &layer)`.
+///          Override the methods that need to be intercepted and call the base method to pass the call on.
+///          Requires `WTK_FS_ADAPTER_DISPATCH` to be set, otherwise `mount` rejects the layer.
+///          The layers share the handle, media and status types of the compiled in backend, so a layer can't bridge
+///          to another middleware, e.g. a FATFS volume next to a FileX one is not supported.
+class AdapterProxy : public IAdapterMethods
+{
+
+public:
+
+    /// @brief Creates the proxy.
+    /// @param inner The adapter receiving the calls, e.g. `FS::adapter`.
+    explicit AdapterProxy(const IAdapterMethods& inner) : m_inner(inner) { }
+
+    Status find(const Path& path, DirectoryEntry& entry) const override { return m_inner.find(path, entry); }
+
+    Status created(const Path& path, DateTime& dateTime) const override { return m_inner.created(path, dateTime); }
+
+    Status modified(const Path& path, DateTime& dateTime) const override { return m_inner.modified(path, dateTime); }
+
+    Status fileCreate(const Path& path) const override { return m_inner.fileCreate(path); }
+
+    Status fileExists(const Path& path) const override { return m_inner.fileExists(path); }
+
+    Status fileOpen(FileControlBlock& file, const Path& path, FileMode mode = FileMode::read) const override { return m_inner.fileOpen(file, path, mode); }
+
+    Status fileSeek(FileControlBlock& file, FileOffset offset) const override { return m_inner.fileSeek(file, offset); }
+
+    Status fileTell(FileControlBlock& file, FileOffset& offset) const override { return m_inner.fileTell(file, offset); }
+
+    Status fileRead(FileControlBlock& file, void* buffer, size_t size, size_t& bytesRead) const override { return m_inner.fileRead(file, buffer, size, bytesRead); }
+
+    Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const override { return m_inner.fileWrite(file, buffer, size); }
+
+    Status fileReadv(FileControlBlock& file, const IOVector* vectors, size_t count, size_t& bytesRead) const override { return m_inner.fileReadv(file, vectors, count, bytesRead); }
+
+    Status fileWritev(FileControlBlock& file, const IOVector* vectors, size_t count) const override { return m_inner.fileWritev(file, vectors, count); }
+
+    Status fileSize(FileControlBlock& file, FileOffset& size) const override { return m_inner.fileSize(file, size); }
+
+    Status fileExpand(FileControlBlock& file, FileOffset size, bool contiguous) const override { return m_inner.fileExpand(file, size, contiguous); }
+
+    Status fileTruncate(FileControlBlock& file) const override { return m_inner.fileTruncate(file); }
+
+    Status fileSync(FileControlBlock& file) const override { return m_inner.fileSync(file); }
+
+    Status fileClose(FileControlBlock& file) const override { return m_inner.fileClose(file); }
+
+    Status fileRename(const Path& oldName, const Path& newName) const override { return m_inner.fileRename(oldName, newName); }
+
+    Status fileDelete(const Path& path) const override { return m_inner.fileDelete(path); }
+
+    Status directoryCreate(const Path& path) const override { return m_inner.directoryCreate(path); }
+
+    Status directoryExists(const Path& path) const override { return m_inner.directoryExists(path); }
+
+    Status directoryRename(const Path& oldName, const Path& newName) const override { return m_inner.directoryRename(oldName, newName); }
+
+    Status directoryDelete(const Path& path) const override { return m_inner.directoryDelete(path); }
+
+    Status directoryOpen(DirectoryHandle& directory, const Path& path) const override { return m_inner.directoryOpen(directory, path); }
+
+    Status directoryRead(DirectoryHandle& directory, EntryInfo& entry) const override { return m_inner.directoryRead(directory, entry); }
+
+    Status directoryClose(DirectoryHandle& directory) const override { return m_inner.directoryClose(directory); }
+
+protected:
+
+    const IAdapterMethods& m_inner; // The adapter receiving the calls.
+
+};
+
+}
@@ -0,0 +1,560 @@
+/**
+ * @file        AdapterRAM.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File system adapter for the static storage RAM disk. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "target.h"
+
+#ifdef USE_RAMFS
+
+#include "AdapterRAM.hpp"
+#include "BitFlags.hpp"
+#include "OS/Mutex.hpp"
+#include <cstring>
+
+static OS::Mutex volumeMutex; // Serializes the access to all RAM disk volumes.
+
+/// @brief Holds the volume mutex for the scope.
+struct VolumeLock
+{
+    VolumeLock() { volumeMutex.acquire(); }
+    ~VolumeLock() { volumeMutex.release(); }
+};
+
+void FS::AdapterRAM::format(Media &media)
+{
+    VolumeLock lock;
+    std::memset(media.entries, 0, sizeof(media.entries));
+    std::memset(media.map, 0, sizeof(media.map));
+    media.freeHint = 0;
+    media.usedCount = 0;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::find(const Path &path, DirectoryEntry &entry) const
+{
+    Media& media = mediaOf(path);
+    char name[nameLength];
+    Status result = normalize(path.relativePath(), name);
+    if (result != OK) return result;
+    VolumeLock lock;
+    DirectoryEntry* found = lookup(media, name);
+    if (!found) return notFound;
+    entry = *found;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::created(const Path &, DateTime &) const
+{
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::modified(const Path &, DateTime &) const
+{
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileCreate(const Path &path) const
+{
+    Media& media = mediaOf(path);
+    char name[nameLength];
+    Status result = normalize(path.relativePath(), name);
+    if (result != OK) return result;
+    VolumeLock lock;
+    DirectoryEntry* entry = lookup(media, name);
+    if (!entry) return create(media, name, false, entry);
+    if (entry->isDirectory || entry->openCount) return denied;
+    truncate(media, *entry);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileExists(const Path &path) const
+{
+    DirectoryEntry entry = {};
+    Status result = find(path, entry);
+    if (result != OK) return result;
+    return entry.isDirectory ? denied : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileOpen(FileControlBlock &file, const Path &path, FileMode mode) const
+{
+    Media& media = mediaOf(path);
+    char name[nameLength];
+    Status result = normalize(path.relativePath(), name);
+    if (result != OK) return result;
+    VolumeLock lock;
+    DirectoryEntry* entry = lookup(media, name);
+    if (entry && entry->isDirectory) return denied;
+    if (BF::isSet(FileMode::createNew, mode))
+    {
+        if (entry) return exists;
+        result = create(media, name, false, entry);
+    }
+    else if (BF::isSet(FileMode::createAlways, mode))
+    {
+        if (!entry) result = create(media, name, false, entry);
+        else if (entry->openCount) return denied;
+        else truncate(media, *entry);
+    }
+    else if (BF::isSet(FileMode::openAlways, mode))
+    {
+        if (!entry) result = create(media, name, false, entry);
+    }
+    else if (!entry) return notFound;
+    if (result != OK) return result;
+    ++entry->openCount;
+    file.volume = &media;
+    file.entry = static_cast<uint32_t>(entry - media.entries);
+    file.offset = (mode & FileMode::openAppend) == FileMode::openAppend ? entry->size : 0;
+    file.mode = static_cast<uint32_t>(mode);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileSeek(FileControlBlock &file, FileOffset offset) const
+{
+    if (!file.volume || file.entry >= entries) return invalid;
+    VolumeLock lock;
+    const DirectoryEntry& entry = file.volume->entries[file.entry];
+    FileMode mode = static_cast<FileMode>(file.mode);
+    bool canWrite = BF::isSet(FileMode::write, mode);
+    file.offset = offset > entry.size && (offset == offsetMax || !canWrite) ? entry.size : offset; // Only writing can go past the end.
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    if (!file.volume || file.entry >= entries) return invalid;
+    offset = file.offset;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
+{
+    IOVector vector { buffer, size };
+    return fileReadv(file, &vector, 1, bytesRead);
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileWrite(FileControlBlock &file, const void *buffer, size_t size) const
+{
+    IOVector vector { const_cast<void*>(buffer), size };
+    return fileWritev(file, &vector, 1);
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileReadv(FileControlBlock &file, const IOVector *vectors, size_t count, size_t &bytesRead) const
+{
+    bytesRead = 0;
+    if (!file.volume || file.entry >= entries) return invalid;
+    FileMode mode = static_cast<FileMode>(file.mode);
+    if (!BF::isSet(FileMode::read, mode)) return denied;
+    VolumeLock lock;
+    Media& media = *file.volume;
+    const DirectoryEntry& entry = media.entries[file.entry];
+    for (size_t i = 0; i < count && file.offset < entry.size; ++i)
+    {
+        size_t length = entry.size - file.offset;
+        if (length > vectors[i].size) length = vectors[i].size;
+        auto target = static_cast<uint8_t*>(vectors[i].data);
+        for (size_t done = 0; done < length; )
+        {
+            size_t chunk = blockSize - file.offset % blockSize;
+            if (chunk > length - done) chunk = length - done;
+            std::memcpy(target + done, locate(media, entry, file.offset), chunk);
+            done += chunk;
+            file.offset += chunk;
+        }
+        bytesRead += length;
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileWritev(FileControlBlock &file, const IOVector *vectors, size_t count) const
+{
+    if (!file.volume || file.entry >= entries) return invalid;
+    FileMode mode = static_cast<FileMode>(file.mode);
+    if (!BF::isSet(FileMode::write, mode)) return denied;
+    size_t size = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (vectors[i].size > offsetMax - file.offset - size) return full;
+        size += vectors[i].size;
+    }
+    if (!size) return OK;
+    VolumeLock lock;
+    Media& media = *file.volume;
+    return writeAt(media, media.entries[file.entry], file, vectors, count, size);
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    if (!file.volume || file.entry >= entries) return invalid;
+    VolumeLock lock;
+    size = file.volume->entries[file.entry].size;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileExpand(FileControlBlock &file, FileOffset size, bool contiguous) const
+{
+    if (!file.volume || file.entry >= entries) return invalid;
+    FileMode mode = static_cast<FileMode>(file.mode);
+    if (!BF::isSet(FileMode::write, mode)) return denied;
+    VolumeLock lock;
+    Media& media = *file.volume;
+    DirectoryEntry& entry = media.entries[file.entry];
+    if (size <= capacity(entry)) return OK;
+    if (contiguous && entry.extentCount) return denied; // Only an empty file can be placed in one run.
+    bool isAllocated = contiguous ? growContiguous(media, entry, size) : grow(media, entry, size);
+    return isAllocated ? OK : full; // The size is not changed, the blocks past it are reserved.
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileTruncate(FileControlBlock &file) const
+{
+    if (!file.volume || file.entry >= entries) return invalid;
+    FileMode mode = static_cast<FileMode>(file.mode);
+    if (!BF::isSet(FileMode::write, mode)) return denied;
+    VolumeLock lock;
+    Media& media = *file.volume;
+    truncate(media, media.entries[file.entry], file.offset);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileSync(FileControlBlock &file) const
+{
+    return file.volume && file.entry < entries ? OK : invalid; // The data is written to the volume directly.
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileClose(FileControlBlock &file) const
+{
+    if (!file.volume || file.entry >= entries) return invalid;
+    VolumeLock lock;
+    DirectoryEntry& entry = file.volume->entries[file.entry];
+    if (entry.openCount) --entry.openCount;
+    file = {};
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileRename(const Path &oldName, const Path &newName) const
+{
+    Media& media = mediaOf(oldName);
+    char name1[nameLength], name2[nameLength];
+    Status result = normalize(oldName.relativePath(), name1);
+    if (result == OK) result = normalize(newName.relativePath(), name2);
+    if (result != OK) return result;
+    VolumeLock lock;
+    DirectoryEntry* entry = lookup(media, name1);
+    if (!entry) return notFound;
+    if (entry->isDirectory || entry->openCount) return denied; // Don't allow directory rename!
+    if (lookup(media, name2)) return exists;
+    if (!parentExists(media, name2)) return notFound;
+    std::strcpy(entry->name, name2);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::fileDelete(const Path &path) const
+{
+    Media& media = mediaOf(path);
+    char name[nameLength];
+    Status result = normalize(path.relativePath(), name);
+    if (result != OK) return result;
+    VolumeLock lock;
+    DirectoryEntry* entry = lookup(media, name);
+    if (!entry) return notFound;
+    if (entry->isDirectory || entry->openCount) return denied; // Don't allow directory delete!
+    truncate(media, *entry);
+    *entry = {};
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::directoryCreate(const Path &path) const
+{
+    Media& media = mediaOf(path);
+    char name[nameLength];
+    Status result = normalize(path.relativePath(), name);
+    if (result != OK) return result;
+    VolumeLock lock;
+    if (lookup(media, name)) return exists;
+    DirectoryEntry* entry = nullptr;
+    return create(media, name, true, entry);
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::directoryExists(const Path &path) const
+{
+    DirectoryEntry entry = {};
+    Status result = find(path, entry);
+    if (result != OK) return result;
+    return entry.isDirectory ? OK : denied;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::directoryRename(const Path &oldName, const Path &newName) const
+{
+    Media& media = mediaOf(oldName);
+    char name1[nameLength], name2[nameLength];
+    Status result = normalize(oldName.relativePath(), name1);
+    if (result == OK) result = normalize(newName.relativePath(), name2);
+    if (result != OK) return result;
+    VolumeLock lock;
+    DirectoryEntry* entry = lookup(media, name1);
+    if (!entry) return notFound;
+    if (!entry->isDirectory) return denied; // Don't allow file rename!
+    if (lookup(media, name2)) return exists;
+    if (!parentExists(media, name2)) return notFound;
+    size_t length1 = std::strlen(name1), length2 = std::strlen(name2);
+    if (length2 > length1 && std::strncmp(name1, name2, length1) == 0 && name2[length1] == '/') return invalid; // Can't move into itself.
+    for (const auto& e : media.entries) // Check that all paths inside will fit first.
+    {
+        if (e.name[0] && std::strncmp(e.name, name1, length1) == 0 && e.name[length1] == '/'
+            && std::strlen(e.name) - length1 + length2 >= nameLength) return invalid;
+    }
+    for (auto& e : media.entries)
+    {
+        if (!e.name[0] || std::strncmp(e.name, name1, length1) != 0 || e.name[length1] != '/') continue;
+        std::memmove(e.name + length2, e.name + length1, std::strlen(e.name) - length1 + 1);
+        std::memcpy(e.name, name2, length2);
+    }
+    std::strcpy(entry->name, name2);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::directoryDelete(const Path &path) const
+{
+    Media& media = mediaOf(path);
+    char name[nameLength];
+    Status result = normalize(path.relativePath(), name);
+    if (result != OK) return result;
+    VolumeLock lock;
+    DirectoryEntry* entry = lookup(media, name);
+    if (!entry) return notFound;
+    if (!entry->isDirectory || hasChildren(media, name)) return denied; // Don't allow file or non-empty directory delete!
+    *entry = {};
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::directoryOpen(DirectoryHandle &directory, const Path &path) const
+{
+    Media& media = mediaOf(path);
+    directory = {};
+    const char* relative = path.relativePath();
+    while (*relative == '/') ++relative;
+    if (*relative) // Not the root directory.
+    {
+        Status result = normalize(relative, directory.path);
+        if (result != OK) return result;
+        VolumeLock lock;
+        DirectoryEntry* entry = lookup(media, directory.path);
+        if (!entry) return notFound;
+        if (!entry->isDirectory) return denied;
+    }
+    directory.volume = &media;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::directoryRead(DirectoryHandle &directory, EntryInfo &entry) const
+{
+    if (!directory.volume) return invalid;
+    entry = {};
+    size_t length = std::strlen(directory.path);
+    VolumeLock lock;
+    for (; directory.next < entries; ++directory.next)
+    {
+        const DirectoryEntry& e = directory.volume->entries[directory.next];
+        if (!e.name[0]) continue;
+        if (length && (std::strncmp(e.name, directory.path, length) != 0 || e.name[length] != '/')) continue;
+        const char* name = length ? e.name + length + 1 : e.name;
+        if (std::strchr(name, '/')) continue; // Not a direct child.
+        std::strcpy(entry.name, name);
+        entry.size = e.size;
+        entry.attributes = e.isDirectory ? EntryAttributes::directory : EntryAttributes::none;
+        ++directory.next;
+        break;
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::directoryClose(DirectoryHandle &directory) const
+{
+    if (!directory.volume) return invalid;
+    directory = {};
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::normalize(const char *path, char *buffer)
+{
+    if (!path) return invalid;
+    while (*path == '/') ++path;
+    size_t length = std::strlen(path);
+    while (length && path[length - 1] == '/') --length;
+    if (!length || length >= nameLength) return invalid;
+    std::memcpy(buffer, path, length);
+    buffer[length] = 0;
+    return OK;
+}
+
+FS::AdapterTypes::DirectoryEntry* FS::AdapterRAM::lookup(Media &media, const char *name)
+{
+    for (auto& e : media.entries) if (e.name[0] && std::strcmp(e.name, name) == 0) return &e;
+    return nullptr;
+}
+
+bool FS::AdapterRAM::parentExists(Media &media, const char *name)
+{
+    const char* separator = std::strrchr(name, '/');
+    if (!separator) return true; // The volume root.
+    size_t length = static_cast<size_t>(separator - name);
+    for (const auto& e : media.entries)
+        if (e.isDirectory && std::strncmp(e.name, name, length) == 0 && e.name[length] == 0) return true;
+    return false;
+}
+
+bool FS::AdapterRAM::hasChildren(Media &media, const char *name)
+{
+    size_t length = std::strlen(name);
+    for (const auto& e : media.entries)
+        if (e.name[0] && std::strncmp(e.name, name, length) == 0 && e.name[length] == '/') return true;
+    return false;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::create(Media &media, const char *name, bool isDirectory, DirectoryEntry*& entry)
+{
+    if (!parentExists(media, name)) return notFound;
+    for (auto& e : media.entries)
+    {
+        if (e.name[0]) continue;
+        e = {};
+        std::strcpy(e.name, name);
+        e.isDirectory = isDirectory;
+        entry = &e;
+        return OK;
+    }
+    return full;
+}
+
+uint32_t FS::AdapterRAM::capacity(const DirectoryEntry &entry)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < entry.extentCount; ++i) count += entry.extents[i].count;
+    return count * blockSize;
+}
+
+bool FS::AdapterRAM::grow(Media &media, DirectoryEntry &entry, uint32_t size)
+{
+    for (uint32_t allocated = capacity(entry); allocated < size; allocated += blockSize)
+    {
+        if (entry.extentCount)
+        {
+            FS_RamExtent& last = entry.extents[entry.extentCount - 1];
+            uint32_t next = last.first + last.count;
+            if (next < blocks && !isUsed(media, next)) // Append to the last run.
+            {
+                mark(media, next, true);
+                ++last.count;
+                continue;
+            }
+        }
+        if (entry.extentCount >= extents) return false;
+        uint32_t block = media.freeHint;
+        while (block < blocks && isUsed(media, block)) ++block;
+        if (block >= blocks) return false;
+        media.freeHint = block; // All blocks below are used.
+        mark(media, block, true);
+        entry.extents[entry.extentCount++] = { block, 1 };
+    }
+    return true;
+}
+
+FS::AdapterTypes::Status FS::AdapterRAM::writeAt(Media &media, DirectoryEntry &entry, FileControlBlock &file, const IOVector *vectors, size_t count, size_t size)
+{
+    uint32_t end = file.offset + static_cast<uint32_t>(size);
+    if (!grow(media, entry, end)) return full; // Either all buffers fit, or nothing is written.
+    for (uint32_t gap = entry.size; gap < file.offset; ) // Writing past the end fills the gap with zeros.
+    {
+        uint32_t chunk = blockSize - gap % blockSize;
+        if (chunk > file.offset - gap) chunk = file.offset - gap;
+        std::memset(locate(media, entry, gap), 0, chunk);
+        gap += chunk;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto source = static_cast<const uint8_t*>(vectors[i].data);
+        for (size_t written = 0; written < vectors[i].size; )
+        {
+            size_t chunk = blockSize - file.offset % blockSize;
+            if (chunk > vectors[i].size - written) chunk = vectors[i].size - written;
+            std::memcpy(locate(media, entry, file.offset), source + written, chunk);
+            written += chunk;
+            file.offset += chunk;
+        }
+    }
+    if (end > entry.size) entry.size = end;
+    return OK;
+}
+
+void FS::AdapterRAM::truncate(Media &media, DirectoryEntry &entry, uint32_t size)
+{
+    uint32_t kept = static_cast<uint32_t>((size + blockSize - 1) / blockSize); // The number of blocks holding the data.
+    uint32_t count = 0;
+    uint32_t i = 0;
+    for (; i < entry.extentCount && count + entry.extents[i].count <= kept; ++i) count += entry.extents[i].count;
+    for (uint32_t j = i; j < entry.extentCount; ++j)
+    {
+        FS_RamExtent& extent = entry.extents[j];
+        uint32_t first = j == i ? kept - count : 0; // The first extent past the size can keep a head.
+        for (uint32_t block = extent.first + first; block < extent.first + extent.count; ++block) mark(media, block, false);
+        extent.count = first;
+    }
+    entry.extentCount = i < entry.extentCount && entry.extents[i].count ? i + 1 : i;
+    if (entry.size > size) entry.size = size;
+}
+
+bool FS::AdapterRAM::growContiguous(Media &media, DirectoryEntry &entry, uint32_t size)
+{
+    uint32_t count = static_cast<uint32_t>((size + blockSize - 1) / blockSize);
+    if (entry.extentCount || !count || count > blocks) return false;
+    for (uint32_t first = media.freeHint; first + count <= blocks; )
+    {
+        uint32_t length = 0;
+        while (length < count && !isUsed(media, first + length)) ++length;
+        if (length < count) // First fit, continue past the used block.
+        {
+            first += length + 1;
+            continue;
+        }
+        for (uint32_t block = first; block < first + count; ++block) mark(media, block, true);
+        entry.extents[entry.extentCount++] = { first, count };
+        return true;
+    }
+    return false;
+}
+
+uint8_t* FS::AdapterRAM::locate(Media &media, const DirectoryEntry &entry, uint32_t offset)
+{
+    uint32_t index = offset / blockSize;
+    for (uint32_t i = 0; i < entry.extentCount; ++i)
+    {
+        const FS_RamExtent& extent = entry.extents[i];
+        if (index < extent.count) return media.blocks[extent.first + index] + offset % blockSize;
+        index -= extent.count;
+    }
+    return nullptr;
+}
+
+void FS::AdapterRAM::mark(Media &media, uint32_t block, bool used)
+{
+    uint8_t bit = static_cast<uint8_t>(1u << (block & 7));
+    if (used)
+    {
+        media.map[block >> 3] |= bit;
+        ++media.usedCount;
+        if (block == media.freeHint) ++media.freeHint;
+    }
+    else
+    {
+        media.map[block >> 3] &= static_cast<uint8_t>(~bit);
+        --media.usedCount;
+        if (block < media.freeHint) media.freeHint = block;
+    }
+}
+
+#endif
@@ -0,0 +1,293 @@
+/**
+ * @file        AdapterRAM.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File system adapter for the static storage RAM disk. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+
+#ifdef USE_RAMFS
+
+#include "IAdapterMethods.hpp"
+
+namespace FS
+{
+
+/// @brief A unified file system access API for the static storage RAM disk.
+/// @remarks The media structure is the whole volume: a directory table, a block bitmap and the data blocks.
+///          A zero initialized volume is empty, so it can be placed in any RAM section and mounted with `MediaServices::mount`
+///          under the root registered for `MediaType::RAM`. Files are stored in up to `WTK_RAMFS_EXTENTS` runs of consecutive blocks.
+///          Appending extends the last run when the next block is free, so sequential writes are O(1) per block.
+///          Timestamps are not stored.
+class AdapterRAM final : public IAdapterMethods
+{
+
+public:
+
+    static constexpr size_t blockSize = WTK_RAMFS_BLOCK_SIZE;   // Data block size in bytes.
+    static constexpr size_t blocks = WTK_RAMFS_BLOCKS;          // The number of data blocks per volume.
+    static constexpr size_t entries = WTK_RAMFS_ENTRIES;        // The number of directory table entries per volume.
+    static constexpr size_t extents = WTK_RAMFS_EXTENTS;        // The maximal number of block runs per file.
+    static constexpr size_t nameLength = WTK_RAMFS_NAME;        // The maximal path length including the terminator.
+
+    static constexpr Status notFound = 1;   // The file or directory doesn't exist.
+    static constexpr Status exists = 2;     // The file or directory already exists.
+    static constexpr Status full = 3;       // No free blocks, directory entries or file extents left.
+    static constexpr Status invalid = 4;    // Invalid path or handle.
+    static constexpr Status denied = 5;     // The operation is not allowed for the entry, or the entry is open.
+
+    /// @brief Removes all files and directories from the volume.
+    /// @param media Media structure reference.
+    static void format(Media& media);
+
+    /// @returns The number of free bytes on the volume.
+    /// @param media Media structure reference.
+    static inline size_t freeSpace(const Media& media) { return (blocks - media.usedCount) * blockSize; }
+
+    /// @brief Finds the directory entry that matches the path.
+    /// @param path File or directory path.
+    /// @param entry Directory entry reference.
+    /// @returns Status.
+    Status find(const Path& path, DirectoryEntry& entry) const override;
+
+    /// @brief Gets the file or directory creation time.
+    /// @param path File or directory path.
+    /// @param dateTime `DateTime` structure reference.
+    /// @returns Status.
+    Status created(const Path& path, DateTime& dateTime) const override;
+
+    /// @brief Gets the file or directory last modification time.
+    /// @param path File or directory path.
+    /// @param dateTime `DateTime` structure reference.
+    /// @returns Status.
+    Status modified(const Path& path, DateTime& dateTime) const override;
+
+    /// @brief Creates a file.
+    /// @param path File path.
+    /// @returns Status.
+    Status fileCreate(const Path& path) const override;
+
+    /// @brief Tests if a file exist on the media.
+    /// @param path File path.
+    /// @returns True if the file exists, false otherwise.
+    Status fileExists(const Path& path) const override;
+
+    /// @brief Opens a file.
+    /// @param file File handle reference.
+    /// @param path A path to the file relative to the file system root.
+    /// @param mode File opening mode. Default opens existing file for reading.
+    /// @returns Status.
+    Status fileOpen(FileControlBlock& file, const Path& path, FileMode mode = FileMode::read) const override;
+
+    /// @brief Moves the file pointer to the specified offset.
+    /// @param file File handle reference.
+    /// @param offset Position within the file.
+    /// @returns Status.
+    Status fileSeek(FileControlBlock& file, FileOffset offset) const override;
+
+    /// @brief Gets the current file pointer.
+    /// @param file File handle reference.
+    /// @param offset Position within the file variable reference.
+    /// @returns Status.
+    Status fileTell(FileControlBlock& file, FileOffset& offset) const override;
+
+    /// @brief Reads data from a file.
+    /// @param file File handle reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size.
+    /// @param bytesRead Number of bytes read variable reference.
+    /// @returns Status.
+    Status fileRead(FileControlBlock& file, void* buffer, size_t size, size_t& bytesRead) const override;
+
+    /// @brief Writes data to a file.
+    /// @param file File handle reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size.
+    /// @returns Status.
+    Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const override;
+
+    /// @brief Reads data from a file into consecutive buffers holding the volume lock once.
+    /// @param file File handle reference.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @param bytesRead Number of bytes read variable reference.
+    /// @returns Status.
+    Status fileReadv(FileControlBlock& file, const IOVector* vectors, size_t count, size_t& bytesRead) const override;
+
+    /// @brief Writes data from consecutive buffers to a file, all or nothing, holding the volume lock once.
+    /// @param file File handle reference.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @returns Status.
+    Status fileWritev(FileControlBlock& file, const IOVector* vectors, size_t count) const override;
+
+    /// @brief Gets the current file size, including the data not synced yet.
+    /// @param file File handle reference.
+    /// @param size File size variable reference.
+    /// @returns Status.
+    Status fileSize(FileControlBlock& file, FileOffset& size) const override;
+
+    /// @brief Reserves the media space for the file data, so the following writes don't allocate it.
+    /// @param file File handle reference.
+    /// @param size The file size in bytes to reserve the space for.
+    /// @param contiguous True to require a single contiguous area.
+    /// @returns Status.
+    Status fileExpand(FileControlBlock& file, FileOffset size, bool contiguous) const override;
+
+    /// @brief Truncates the file at the current file pointer, releasing the space reserved past it.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileTruncate(FileControlBlock& file) const override;
+
+    /// @brief Writes the cached file data and the directory entry to the media.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileSync(FileControlBlock& file) const override;
+
+    /// @brief Closes a file.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileClose(FileControlBlock& file) const override;
+
+    /// @brief Renames a file.
+    /// @param oldName Old file name.
+    /// @param newName New file name.
+    /// @returns Status.
+    Status fileRename(const Path& oldName, const Path& newName) const override;
+
+    /// @brief Deletes a file.
+    /// @param path File name.
+    /// @returns Status.
+    Status fileDelete(const Path& path) const override;
+
+    /// @brief Creates a directory on the media.
+    /// @param path Directory name.
+    /// @returns Status.
+    Status directoryCreate(const Path& path) const override;
+
+    /// @brief Tests if a directory exists on the media.
+    /// @param path Directory name.
+    /// @returns Status.
+    Status directoryExists(const Path& path) const override;
+
+    /// @brief Renames a directory on the media.
+    /// @param oldName Old directory name.
+    /// @param newName New directory name.
+    /// @returns Status.
+    Status directoryRename(const Path& oldName, const Path& newName) const override;
+
+    /// @brief Deletes a directory from the media.
+    /// @param path Directory name.
+    /// @returns Status code.
+    Status directoryDelete(const Path& path) const override;
+
+    /// @brief Opens a directory for the entry enumeration.
+    /// @param directory Directory handle reference.
+    /// @param path Directory path, can be the file system root.
+    /// @returns Status code.
+    Status directoryOpen(DirectoryHandle& directory, const Path& path) const override;
+
+    /// @brief Reads the next directory entry.
+    /// @param directory Directory handle reference.
+    /// @param entry Entry information reference. The name is set empty at the end of the directory.
+    /// @returns Status code.
+    Status directoryRead(DirectoryHandle& directory, EntryInfo& entry) const override;
+
+    /// @brief Closes the directory handle.
+    /// @param directory Directory handle reference.
+    /// @returns Status code.
+    Status directoryClose(DirectoryHandle& directory) const override;
+
+private:
+
+    /// @brief Copies the normalized path, without leading and trailing slashes.
+    /// @param path Path relative to the volume root.
+    /// @param buffer Target buffer of `nameLength` bytes.
+    /// @returns Status.
+    static Status normalize(const char* path, char* buffer);
+
+    /// @returns The directory table entry matching the normalized path, or `nullptr` if not found.
+    /// @param media Media structure reference.
+    /// @param name Normalized path.
+    static DirectoryEntry* lookup(Media& media, const char* name);
+
+    /// @returns True if the parent directory of the normalized path exists.
+    /// @param media Media structure reference.
+    /// @param name Normalized path.
+    static bool parentExists(Media& media, const char* name);
+
+    /// @returns True if any entry is located in the directory.
+    /// @param media Media structure reference.
+    /// @param name Normalized directory path.
+    static bool hasChildren(Media& media, const char* name);
+
+    /// @brief Adds a directory table entry.
+    /// @param media Media structure reference.
+    /// @param name Normalized path.
+    /// @param isDirectory True for a directory entry.
+    /// @param entry Created entry pointer reference.
+    /// @returns Status.
+    static Status create(Media& media, const char* name, bool isDirectory, DirectoryEntry*& entry);
+
+    /// @returns The number of bytes the allocated blocks of the entry can hold.
+    /// @param entry Directory table entry.
+    static uint32_t capacity(const DirectoryEntry& entry);
+
+    /// @brief Allocates blocks until the entry capacity reaches the size.
+    /// @param media Media structure reference.
+    /// @param entry Directory table entry.
+    /// @param size Required capacity in bytes.
+    /// @returns True if allocated, false if the volume or the entry extents are full.
+    static bool grow(Media& media, DirectoryEntry& entry, uint32_t size);
+
+    /// @brief Writes data at the file offset, allocating the blocks and zero filling the gap before the offset.
+    /// @param media Media structure reference.
+    /// @param entry Directory table entry.
+    /// @param file File handle reference, the offset is advanced.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @param size The total size of the buffers.
+    /// @returns Status.
+    static Status writeAt(Media& media, DirectoryEntry& entry, FileControlBlock& file, const IOVector* vectors, size_t count, size_t size);
+
+    /// @brief Frees the blocks of the entry past the size and limits its size.
+    /// @param media Media structure reference.
+    /// @param entry Directory table entry.
+    /// @param size The new size in bytes, 0 frees all blocks.
+    static void truncate(Media& media, DirectoryEntry& entry, uint32_t size = 0);
+
+    /// @brief Allocates the first free run of blocks for an entry without blocks.
+    /// @param media Media structure reference.
+    /// @param entry Directory table entry.
+    /// @param size Required capacity in bytes.
+    /// @returns True if allocated, false if there is no free run long enough.
+    static bool growContiguous(Media& media, DirectoryEntry& entry, uint32_t size);
+
+    /// @returns The address of the byte at the file offset, the rest of its block is contiguous.
+    /// @param media Media structure reference.
+    /// @param entry Directory table entry.
+    /// @param offset File offset within the entry capacity.
+    static uint8_t* locate(Media& media, const DirectoryEntry& entry, uint32_t offset);
+
+    /// @returns True if the block is used.
+    /// @param media Media structure reference.
+    /// @param block Block index.
+    static inline bool isUsed(const Media& media, uint32_t block) { return media.map[block >> 3] & (1u << (block & 7)); }
+
+    /// @brief Marks the block as used or free.
+    /// @param media Media structure reference.
+    /// @param block Block index.
+    /// @param used True to mark used, false to mark free.
+    static void mark(Media& media, uint32_t block, bool used);
+
+};
+
+}
+
+#endif
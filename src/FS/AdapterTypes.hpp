@@ -11,6 +11,7 @@
 #pragma once
 
 #include "BitFlags.hpp"
+#include "DateTime.hpp"
 #include "fs_bindings.h"
 #include <cstdint>
 #include <cstddef>
@@ -32,9 +33,28 @@ enum class FileMode : uint32_t
     openAppend      = 0x30  // Set read/write pointer to the end of the file.
 };
 
+/// @brief Directory entry attribute flags.
+/// @remark Values made to match FATFS and FILEX attributes directly.
+enum class EntryAttributes : uint32_t
+{
+    none            = 0x00, // A regular file.
+    readOnly        = 0x01, // The entry is read only.
+    hidden          = 0x02, // The entry is hidden.
+    system          = 0x04, // The entry is a system entry.
+    directory       = 0x10, // The entry is a directory.
+    archive         = 0x20  // The entry was modified since archived.
+};
+
 /// @brief Optional number of bytes read from a file if the operation was successful.
 using ReadResult = std::optional<size_t>;
 
+/// @brief One buffer of a vectored (scatter / gather) file read or write.
+struct IOVector
+{
+    void* data;     // Buffer pointer.
+    size_t size;    // Buffer size in bytes.
+};
+
 /// @brief A placeholder structure for a NULL file system.
 using Placeholder = FS_Placeholder;
 
@@ -47,6 +67,7 @@ public:
     using Media = FS_Media;                         // Media structure type.
     using DirectoryEntry = FS_DirectoryEntry;       // Directory entry structure type.
     using FileControlBlock = FS_FileControlBlock;   // File handle structure type.
+    using DirectoryHandle = FS_DirectoryHandle;     // Directory enumeration handle structure type.
     using FileOffset = FS_FileOffset;               // File offset number type.
     using Status = FS_Status;                       // I/O operation status type.
 
@@ -55,21 +76,52 @@ public:
     static constexpr size_t lfnMaxLength = FX_MAX_LONG_NAME_LEN;    // Maximum length of the path string.
     static constexpr Status OK = FX_SUCCESS;                        // Successful operation status.
     static constexpr FileOffset offsetMax = -1UL;                   // Last possible file offset.
+    static constexpr size_t sectorSize = 512;                       // Media sector size used to align buffered writes.
+    static constexpr bool caseSensitive = false;                    // Entry names are case insensitive.
 
 #elif defined(USE_FATFS)
 
     static constexpr size_t lfnMaxLength = _MAX_LFN;    // Maximum length of the path string.
     static constexpr Status OK = FR_OK;                 // Successful operation status.
     static constexpr FileOffset offsetMax = -1UL;       // Last possible file offset.
+    static constexpr size_t sectorSize = _MAX_SS;       // Media sector size used to align buffered writes.
+    static constexpr bool caseSensitive = false;        // Entry names are case insensitive.
+
+#elif defined(USE_POSIX)
+
+    static constexpr size_t lfnMaxLength = 256;     // Maximum length of the path string.
+    static constexpr Status OK = 0;                 // Successful operation status.
+    static constexpr FileOffset offsetMax = -1ULL;  // Last possible file offset.
+    static constexpr size_t sectorSize = 4096;      // Host page size used to align buffered writes.
+    static constexpr bool caseSensitive = true;     // Entry names are case sensitive.
+
+#elif defined(USE_RAMFS)
+
+    static constexpr size_t lfnMaxLength = 256;     // Maximum length of the path string.
+    static constexpr Status OK = 0;                 // Successful operation status.
+    static constexpr FileOffset offsetMax = static_cast<FileOffset>(-1); // Last possible file offset.
+    static constexpr size_t sectorSize = WTK_RAMFS_BLOCK_SIZE;  // Block size used to align buffered writes.
+    static constexpr bool caseSensitive = true;     // Entry names are case sensitive.
 
 #else
 
     static constexpr size_t lfnMaxLength = 256;     // Maximum length of the path string.
     static constexpr Status OK = 0;                 // Successful operation status.
     static constexpr FileOffset offsetMax = -1UL;   // Last possible file offset.
+    static constexpr size_t sectorSize = 512;       // Media sector size used to align buffered writes.
+    static constexpr bool caseSensitive = true;     // Entry names are case sensitive.
 
 #endif
 
 };
 
+/// @brief Directory entry information returned by the directory enumeration.
+struct EntryInfo
+{
+    char name[AdapterTypes::lfnMaxLength + 1];  // Entry name, without the directory path.
+    uint64_t size;                              // File size in bytes.
+    EntryAttributes attributes;                 // Attribute flags.
+    DateTime modified;                          // Last modification time, empty if not provided by the backend.
+};
+
 }
@@ -0,0 +1,220 @@
+/**
+ * @file        BlockCache.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Sector cache between FATFS and the disk I/O drivers. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "BlockCache.hpp"
+
+#ifdef USE_FATFS
+
+#include <cstring>
+
+const Diskio_drvTypeDef* FS::BlockCache::wrap(const Diskio_drvTypeDef *driver)
+{
+    static constexpr auto functions = bindAll(std::make_index_sequence<drivers>());
+    if (!blocks || !driver) return driver;
+    m_mutex.acquire();
+    size_t index = 0;
+    while (index < drivers && m_wrapped[index] && m_wrapped[index] != driver) ++index;
+    if (index == drivers) // No slot left.
+    {
+        m_mutex.release();
+        return driver;
+    }
+    m_wrapped[index] = driver;
+    Diskio_drvTypeDef& caching = m_caching[index];
+    caching.disk_initialize = functions.items[index].initialize;
+    caching.disk_status = functions.items[index].status;
+    caching.disk_read = functions.items[index].read;
+#if !defined(_USE_WRITE) || _USE_WRITE == 1
+    caching.disk_write = functions.items[index].write;
+#endif
+#if !defined(_USE_IOCTL) || _USE_IOCTL == 1
+    caching.disk_ioctl = functions.items[index].ioctl;
+#endif
+    m_mutex.release();
+    return &caching;
+}
+
+bool FS::BlockCache::flush(void)
+{
+    if (!blocks) return true;
+    m_mutex.acquire();
+    DRESULT result = writeBackAll(drivers, 0);
+    m_mutex.release();
+    return result == RES_OK;
+}
+
+bool FS::BlockCache::invalidate(void)
+{
+    if (!blocks) return true;
+    m_mutex.acquire();
+    DRESULT result = writeBackAll(drivers, 0);
+    for (auto& b : m_blocks) b.isValid = b.isDirty = b.isReferenced = false;
+    m_hand = 0;
+    m_mutex.release();
+    return result == RES_OK;
+}
+
+DSTATUS FS::BlockCache::initialize(size_t driver, BYTE lun)
+{
+    m_mutex.acquire();
+    // The media could be changed, the sectors of the previous one, dirty or not, must not be written to the new one.
+    for (auto& b : m_blocks) if (b.isValid && b.driver == driver && b.lun == lun) b.isValid = b.isDirty = b.isReferenced = false;
+    m_mutex.release();
+    return m_wrapped[driver]->disk_initialize(lun);
+}
+
+DRESULT FS::BlockCache::read(size_t driver, BYTE lun, BYTE *buffer, DWORD sector, UINT count)
+{
+    const Diskio_drvTypeDef* media = m_wrapped[driver];
+    DRESULT result = RES_OK;
+    m_mutex.acquire();
+    if (count > maxCachedCount)
+    {
+        result = media->disk_read(lun, buffer, sector, count);
+        if (result == RES_OK)
+        {
+            m_statistics.bypassed += count;
+            for (const auto& b : m_blocks) // The cached data not written back yet is newer.
+                if (b.isDirty && b.driver == driver && b.lun == lun && b.sector - sector < count)
+                    std::memcpy(buffer + (b.sector - sector) * blockSize, b.data, blockSize);
+        }
+    }
+    else for (UINT i = 0; i < count; ++i)
+    {
+        Block* block = find(driver, lun, sector + i);
+        if (block) ++m_statistics.hits;
+        else
+        {
+            block = replace();
+            if (!block)
+            {
+                result = RES_ERROR;
+                break;
+            }
+            result = media->disk_read(lun, block->data, sector + i, 1);
+            if (result != RES_OK) break;
+            block->sector = sector + i;
+            block->driver = static_cast<uint8_t>(driver);
+            block->lun = lun;
+            block->isValid = true;
+            ++m_statistics.misses;
+        }
+        block->isReferenced = true;
+        std::memcpy(buffer + i * blockSize, block->data, blockSize);
+    }
+    m_mutex.release();
+    return result;
+}
+
+DRESULT FS::BlockCache::write(size_t driver, BYTE lun, const BYTE *buffer, DWORD sector, UINT count)
+{
+    DRESULT result = RES_OK;
+    m_mutex.acquire();
+    if (count > maxCachedCount)
+    {
+        result = m_wrapped[driver]->disk_write(lun, buffer, sector, count);
+        if (result == RES_OK)
+        {
+            m_statistics.bypassed += count;
+            for (auto& b : m_blocks) // Update the cached copies, the dirty ones are superseded.
+            {
+                if (!b.isValid || b.driver != driver || b.lun != lun || b.sector - sector >= count) continue;
+                std::memcpy(b.data, buffer + (b.sector - sector) * blockSize, blockSize);
+                b.isDirty = false;
+            }
+        }
+    }
+    else for (UINT i = 0; i < count; ++i)
+    {
+        Block* block = find(driver, lun, sector + i);
+        if (!block)
+        {
+            block = replace();
+            if (!block)
+            {
+                result = RES_ERROR;
+                break;
+            }
+            block->sector = sector + i;
+            block->driver = static_cast<uint8_t>(driver);
+            block->lun = lun;
+            block->isValid = true;
+        }
+        std::memcpy(block->data, buffer + i * blockSize, blockSize);
+        block->isDirty = true;
+        block->isReferenced = true;
+        ++m_statistics.writes;
+    }
+    m_mutex.release();
+    return result;
+}
+
+DRESULT FS::BlockCache::ioctl(size_t driver, BYTE lun, BYTE command, void *buffer)
+{
+    if (command == CTRL_SYNC)
+    {
+        m_mutex.acquire();
+        DRESULT result = writeBackAll(driver, lun);
+        m_mutex.release();
+        if (result != RES_OK) return result;
+    }
+    return m_wrapped[driver]->disk_ioctl(lun, command, buffer);
+}
+
+FS::BlockCache::Block* FS::BlockCache::find(size_t driver, BYTE lun, DWORD sector)
+{
+    for (auto& b : m_blocks) if (b.isValid && b.sector == sector && b.driver == driver && b.lun == lun) return &b;
+    return nullptr;
+}
+
+FS::BlockCache::Block* FS::BlockCache::replace(void)
+{
+    for (size_t n = 0; n <= 2 * slots; ++n) // Each buffer is passed at most twice: once to clear the reference bit.
+    {
+        Block& b = m_blocks[m_hand];
+        m_hand = (m_hand + 1) % slots;
+        if (b.isValid && b.isReferenced)
+        {
+            b.isReferenced = false; // Second chance.
+            continue;
+        }
+        if (b.isValid)
+        {
+            if (b.isDirty && writeBack(b) != RES_OK) return nullptr;
+            ++m_statistics.evictions;
+        }
+        b.isValid = b.isDirty = b.isReferenced = false;
+        return &b;
+    }
+    return nullptr;
+}
+
+DRESULT FS::BlockCache::writeBack(Block &block)
+{
+    DRESULT result = m_wrapped[block.driver]->disk_write(block.lun, block.data, block.sector, 1);
+    if (result != RES_OK) return result;
+    block.isDirty = false;
+    ++m_statistics.writeBacks;
+    return RES_OK;
+}
+
+DRESULT FS::BlockCache::writeBackAll(size_t driver, BYTE lun)
+{
+    DRESULT result = RES_OK;
+    for (auto& b : m_blocks)
+    {
+        if (!b.isDirty || (driver < drivers && (b.driver != driver || b.lun != lun))) continue;
+        DRESULT blockResult = writeBack(b);
+        if (result == RES_OK) result = blockResult;
+    }
+    return result;
+}
+
+#endif
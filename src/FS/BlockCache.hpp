@@ -0,0 +1,195 @@
+/**
+ * @file        BlockCache.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Sector cache between FATFS and the disk I/O drivers. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+
+#ifdef USE_FATFS
+
+#include "fatfs.h"
+#include "StaticClass.hpp"
+#include "OS/Mutex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#ifndef WTK_FS_BLOCK_CACHE
+#define WTK_FS_BLOCK_CACHE 0
+#endif
+
+#ifndef WTK_FS_BLOCK_CACHE_DRIVERS
+#define WTK_FS_BLOCK_CACHE_DRIVERS 2
+#endif
+
+namespace FS
+{
+
+/// @brief Write-back sector cache between FATFS and the disk I/O drivers (`Diskio_drvTypeDef`).
+/// @remarks `MediaServices::registerType` stores the wrapped driver, so it's linked instead of the original one.
+///          Other drivers can be wrapped explicitly: `FATFS_LinkDriver(BlockCache::wrap(&SD_Driver), path)`.
+///          Reads and writes up to `maxCachedCount` sectors go through `WTK_FS_BLOCK_CACHE` static sector buffers,
+///          so the FAT, directory and small random data accesses don't hit the media every time.
+///          Longer transfers go directly to the driver, the cached copies are kept coherent.
+///          Buffers are replaced with the CLOCK (second chance) policy, dirty buffers are written back when replaced,
+///          on the `CTRL_SYNC` control command (`f_sync`, `f_close`) and on `MediaServices::umount`.
+///          Sectors are assumed to be `_MAX_SS` bytes long.
+///          All wrapped drivers share the buffers and one mutex. Disabled when `WTK_FS_BLOCK_CACHE` is 0 (default).
+class BlockCache final
+{
+
+    STATIC(BlockCache)
+
+public:
+
+    static constexpr size_t blocks = WTK_FS_BLOCK_CACHE;            // The number of sector buffers.
+    static constexpr size_t drivers = WTK_FS_BLOCK_CACHE_DRIVERS;   // The maximal number of wrapped drivers.
+    static constexpr size_t blockSize = _MAX_SS;                    // Sector buffer size in bytes.
+    static constexpr UINT maxCachedCount = 4;                       // Longer transfers bypass the cache.
+
+    /// @brief Cache statistics.
+    struct Statistics
+    {
+        uint32_t hits;          // The number of sectors read from the cache.
+        uint32_t misses;        // The number of sectors read from the media into the cache.
+        uint32_t bypassed;      // The number of sectors transferred directly, bypassing the cache.
+        uint32_t writes;        // The number of sectors written to the cache.
+        uint32_t writeBacks;    // The number of dirty sectors written to the media.
+        uint32_t evictions;     // The number of valid sectors replaced.
+    };
+
+    /// @brief Wraps a disk I/O driver with the cache.
+    /// @param driver The media driver.
+    /// @returns The caching driver to link with FATFS, or the original driver if the cache is disabled or no slot is left.
+    static const Diskio_drvTypeDef* wrap(const Diskio_drvTypeDef* driver);
+
+    /// @brief Writes the dirty sectors to the media.
+    /// @returns True if all dirty sectors were written.
+    static bool flush(void);
+
+    /// @brief Writes the dirty sectors to the media and discards all cached sectors, e.g. when the media is removed.
+    /// @returns True if all dirty sectors were written. The sectors that failed are discarded anyway.
+    static bool invalidate(void);
+
+    /// @returns Cache statistics.
+    static inline const Statistics& statistics(void) { return m_statistics; }
+
+    /// @brief Zeroes the cache statistics.
+    static inline void resetStatistics(void) { m_statistics = {}; }
+
+private:
+
+    /// @brief A cached sector.
+    struct Block
+    {
+        alignas(32) uint8_t data[blockSize];    // Sector data, aligned for DMA transfers.
+        DWORD sector;                           // Sector number.
+        uint8_t driver;                         // Wrapped driver index.
+        BYTE lun;                               // Logical unit number.
+        bool isValid;                           // True if the buffer contains a sector.
+        bool isDirty;                           // True if the sector was modified and not written back.
+        bool isReferenced;                      // CLOCK reference bit, set on each access.
+    };
+
+    /// @brief Driver function set bound to a wrapped driver index.
+    struct Functions
+    {
+        DSTATUS (*initialize)(BYTE);
+        DSTATUS (*status)(BYTE);
+        DRESULT (*read)(BYTE, BYTE*, DWORD, UINT);
+        DRESULT (*write)(BYTE, const BYTE*, DWORD, UINT);
+        DRESULT (*ioctl)(BYTE, BYTE, void*);
+    };
+
+    /// @returns The functions bound to the driver index.
+    template<size_t index> static constexpr Functions bind(void)
+    {
+        return {
+            [](BYTE lun) { return initialize(index, lun); },
+            [](BYTE lun) { return m_wrapped[index]->disk_status(lun); },
+            [](BYTE lun, BYTE* buffer, DWORD sector, UINT count) { return read(index, lun, buffer, sector, count); },
+            [](BYTE lun, const BYTE* buffer, DWORD sector, UINT count) { return write(index, lun, buffer, sector, count); },
+            [](BYTE lun, BYTE command, void* buffer) { return ioctl(index, lun, command, buffer); }
+        };
+    }
+
+    /// @returns The function sets for all driver indices.
+    template<size_t... index> static constexpr auto bindAll(std::index_sequence<index...>)
+    {
+        struct Table { Functions items[sizeof...(index)]; };
+        return Table { { bind<index>()... } };
+    }
+
+    /// @brief Initializes the media, discarding the cached sectors of the logical unit without writing the dirty ones back.
+    /// @param driver Wrapped driver index.
+    /// @param lun Logical unit number.
+    /// @returns Media status.
+    static DSTATUS initialize(size_t driver, BYTE lun);
+
+    /// @brief Reads sectors through the cache.
+    /// @param driver Wrapped driver index.
+    /// @param lun Logical unit number.
+    /// @param buffer Target buffer.
+    /// @param sector The first sector number.
+    /// @param count The number of sectors.
+    /// @returns Result.
+    static DRESULT read(size_t driver, BYTE lun, BYTE* buffer, DWORD sector, UINT count);
+
+    /// @brief Writes sectors through the cache.
+    /// @param driver Wrapped driver index.
+    /// @param lun Logical unit number.
+    /// @param buffer Source buffer.
+    /// @param sector The first sector number.
+    /// @param count The number of sectors.
+    /// @returns Result.
+    static DRESULT write(size_t driver, BYTE lun, const BYTE* buffer, DWORD sector, UINT count);
+
+    /// @brief Passes a control command to the driver, writing the dirty sectors first on `CTRL_SYNC`.
+    /// @param driver Wrapped driver index.
+    /// @param lun Logical unit number.
+    /// @param command Control command.
+    /// @param buffer Command parameter buffer.
+    /// @returns Result.
+    static DRESULT ioctl(size_t driver, BYTE lun, BYTE command, void* buffer);
+
+    /// @returns The cached sector or `nullptr` if not cached.
+    /// @param driver Wrapped driver index.
+    /// @param lun Logical unit number.
+    /// @param sector Sector number.
+    static Block* find(size_t driver, BYTE lun, DWORD sector);
+
+    /// @brief Selects a buffer to replace with the CLOCK policy and writes it back if dirty.
+    /// @returns The buffer, or `nullptr` if the dirty sector could not be written back.
+    static Block* replace(void);
+
+    /// @brief Writes a dirty sector back to the media.
+    /// @param block Block reference.
+    /// @returns Result.
+    static DRESULT writeBack(Block& block);
+
+    /// @brief Writes back the dirty sectors of a logical unit, or all units.
+    /// @param driver Wrapped driver index, `drivers` for all drivers.
+    /// @param lun Logical unit number.
+    /// @returns Result, the first error if any write failed.
+    static DRESULT writeBackAll(size_t driver, BYTE lun);
+
+    static constexpr size_t slots = blocks ? blocks : 1;                        // The buffer array size.
+    static inline Block m_blocks[slots] = {};                                   // Sector buffers.
+    static inline const Diskio_drvTypeDef* m_wrapped[drivers] = {};             // Wrapped drivers.
+    static inline Diskio_drvTypeDef m_caching[drivers] = {};                    // Caching drivers.
+    static inline OS::Mutex m_mutex = {};                                       // Serializes the cache access.
+    static inline size_t m_hand = 0;                                            // CLOCK hand, the next buffer to test.
+    static inline Statistics m_statistics = {};                                 // Cache statistics.
+
+};
+
+}
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * @file        Copy.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Pipelined file copy between file systems. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Copy.hpp"
+#include "Crc32.hpp"
+
+static constexpr OS::EventFlags startBit = 1;   // A copy was started.
+static constexpr OS::EventFlags filledBit = 2;  // The reader filled a slot or finished.
+static constexpr OS::EventFlags freedBit = 4;   // The writer freed a slot or stopped.
+
+FS::Copy::Result FS::Copy::run(const FileSystem *srcFs, const char *srcPath, const FileSystem *dstFs, const char *dstPath, const CopyOptions &options)
+{
+    Result result = {};
+    size_t count = options.buffers;
+    size_t slotSize = count ? options.size / count : 0;
+    if (slotSize >= AdapterTypes::sectorSize) slotSize -= slotSize % AdapterTypes::sectorSize; // Whole sectors per transfer.
+    if (!srcFs || !srcPath || !dstFs || !dstPath || !options.buffer || count < 2 || count > maxBuffers || !slotSize)
+    {
+        result.status = invalid;
+        return result;
+    }
+    File source(srcFs, "%s", FileMode::read, srcPath);
+    if (!source)
+    {
+        result.status = openFailed;
+        return result;
+    }
+    AdapterTypes::FileOffset total = 0;
+    if (!source.seek(AdapterTypes::offsetMax) || !source.tell(total) || !source.seek(0)) total = 0; // Size unknown.
+    File target(dstFs, "%s", FileMode::write | FileMode::createAlways, dstPath);
+    if (!target)
+    {
+        result.status = openFailed;
+        return result;
+    }
+    m_mutex.acquire();
+    if (!m_isStarted)
+    {
+        m_thread.start(readerEntry, "Copy", OS::ThreadPriority::aboveNormal);
+        m_isStarted = true;
+    }
+    uint8_t* data = static_cast<uint8_t*>(options.buffer);
+    for (size_t i = 0; i < count; ++i) m_slots[i] = { data + i * slotSize, 0 };
+    m_count = count;
+    m_slotSize = slotSize;
+    m_source = &source;
+    m_filled = 0;
+    m_written = 0;
+    m_isEnd = false;
+    m_isStopped = false;
+    m_isVerified = options.verify;
+    m_readFailed = false;
+    m_crc = 0;
+    m_readerStalls = 0;
+    m_events.clear(filledBit | freedBit);
+    OS::TickCount begin = OS::getTick();
+    m_events.signal(startBit);
+    Status status = done;
+    for (;;)
+    {
+        bool isEnd = m_isEnd; // Tested first, the reader sets it after the last slot is filled.
+        size_t written = m_written;
+        if (written == m_filled)
+        {
+            if (isEnd) break;
+            ++result.writerStalls;
+            m_events.wait(filledBit);
+            continue;
+        }
+        const Slot& slot = m_slots[written % count];
+        if (!target.write(slot.data, slot.length))
+        {
+            status = writeFailed;
+            break;
+        }
+        result.bytes += slot.length;
+        m_written = written + 1;
+        m_events.signal(freedBit);
+        if (options.cancel && options.cancel->load())
+        {
+            status = cancelled;
+            break;
+        }
+        if (options.progress)
+        {
+            OS::TickCount elapsed = OS::getTick() - begin;
+            uint32_t bytesPerSecond = elapsed ? static_cast<uint32_t>(result.bytes * WTK_OS_TICKS_PER_SECOND / elapsed) : 0;
+            if (!options.progress({ result.bytes, total, bytesPerSecond }, options.context))
+            {
+                status = cancelled;
+                break;
+            }
+        }
+    }
+    m_isStopped = true;
+    m_events.signal(freedBit); // Wakes the reader waiting for a free slot.
+    while (!m_isEnd) m_events.wait(filledBit);
+    if (status == done && m_readFailed) status = readFailed;
+    if (status == done && !target.flush()) status = writeFailed;
+    result.time = OS::getTick() - begin;
+    result.bytesPerSecond = result.time ? static_cast<uint32_t>(result.bytes * WTK_OS_TICKS_PER_SECOND / result.time) : 0;
+    result.crc = m_crc;
+    result.readerStalls = m_readerStalls;
+    m_source = nullptr;
+    m_mutex.release();
+    target.close();
+    if (status == done && options.verify)
+    {
+        uint32_t crc = 0;
+        if (!targetCrc(dstFs, dstPath, data, count * slotSize, crc) || crc != result.crc) status = verifyFailed;
+    }
+    result.status = status;
+    return result;
+}
+
+void FS::Copy::readerEntry(OS::ThreadArg)
+{
+    for (;;)
+    {
+        m_events.wait(startBit);
+        size_t filled = 0;
+        while (!m_isStopped)
+        {
+            if (filled - m_written >= m_count) // All slots are filled.
+            {
+                ++m_readerStalls;
+                m_events.wait(freedBit);
+                continue;
+            }
+            Slot& slot = m_slots[filled % m_count];
+            ReadResult result = m_source->read(slot.data, m_slotSize);
+            if (!result.has_value())
+            {
+                m_readFailed = true;
+                break;
+            }
+            slot.length = result.value();
+            if (!slot.length) break; // End of file.
+            if (m_isVerified) m_crc = Crc32::update(m_crc, slot.data, slot.length);
+            m_filled = ++filled;
+            m_events.signal(filledBit);
+            if (slot.length < m_slotSize) break; // End of file.
+        }
+        m_isEnd = true;
+        m_events.signal(filledBit);
+    }
+}
+
+bool FS::Copy::targetCrc(const FileSystem *dstFs, const char *dstPath, uint8_t *buffer, size_t size, uint32_t &crc)
+{
+    File target(dstFs, "%s", FileMode::read, dstPath);
+    if (!target) return false;
+    crc = 0;
+    for (;;)
+    {
+        ReadResult result = target.read(buffer, size);
+        if (!result.has_value()) return false;
+        if (!result.value()) return true;
+        crc = Crc32::update(crc, buffer, result.value());
+        if (result.value() < size) return true;
+    }
+}
@@ -0,0 +1,143 @@
+/**
+ * @file        Copy.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Pipelined file copy between file systems. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Action.hpp"
+#include "File.hpp"
+#include "StaticClass.hpp"
+#include "OS/EventGroup.hpp"
+#include "OS/Mutex.hpp"
+#include "OS/Thread.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace FS
+{
+
+/// @brief Copy progress information.
+struct CopyProgress
+{
+    uint64_t bytes;             // The number of bytes written.
+    uint64_t total;             // The source file size in bytes.
+    uint32_t bytesPerSecond;    // Average throughput since the copy started.
+};
+
+/// @brief Copy options.
+struct CopyOptions
+{
+    void* buffer = nullptr;                                         // Ring buffer memory, split into `buffers` slots.
+    size_t size = 0;                                                // Ring buffer size in bytes.
+    size_t buffers = 2;                                             // The number of ring slots, 2 to `Copy::maxBuffers`.
+    bool verify = false;                                            // Re-read the target and compare its CRC32 with the source.
+    Fn2<const CopyProgress&, void*, bool> progress = nullptr;       // Called after each written slot, returns false to cancel.
+    void* context = nullptr;                                        // Progress callback context.
+    const std::atomic<bool>* cancel = nullptr;                      // Set to true from any thread to cancel the copy.
+};
+
+/// @brief Copies files reading the source on a background thread while the calling thread writes the target.
+/// @remarks The reader fills the ring slots ahead of the writer, so both media work at the same time.
+///          The shared copy thread is started on the first use. Copies are serialized, one runs at a time.
+///          A cancelled or failed copy leaves the partially written target file.
+class Copy final
+{
+
+    STATIC(Copy)
+
+public:
+
+    static constexpr size_t maxBuffers = 8; // The maximal number of ring slots.
+
+    /// @brief Copy result status.
+    enum Status : uint8_t
+    {
+        done,           // The file was copied (and verified if requested).
+        invalid,        // Invalid paths or options.
+        openFailed,     // The source or the target file could not be opened.
+        readFailed,     // The source file read failed.
+        writeFailed,    // The target file write failed.
+        verifyFailed,   // The target file CRC32 doesn't match the source.
+        cancelled       // The copy was cancelled.
+    };
+
+    /// @brief Copy result.
+    struct Result
+    {
+        Status status;              // Result status.
+        uint64_t bytes;             // The number of bytes written.
+        uint32_t crc;               // The source data CRC32 (IEEE 802.3), 0 if not verified.
+        OS::TickCount time;         // Copy time in system ticks, without the verification.
+        uint32_t bytesPerSecond;    // Average copy throughput.
+        uint32_t readerStalls;      // The number of times the reader waited for a free slot.
+        uint32_t writerStalls;      // The number of times the writer waited for a filled slot.
+    };
+
+    /// @brief Copies a file.
+    /// @param srcFs Source file system pointer.
+    /// @param srcPath Source file path.
+    /// @param dstFs Target file system pointer.
+    /// @param dstPath Target file path, the file is overwritten if exists.
+    /// @param options Copy options.
+    /// @returns Result.
+    static Result run(const FileSystem* srcFs, const char* srcPath, const FileSystem* dstFs, const char* dstPath, const CopyOptions& options);
+
+private:
+
+    /// @brief Ring slot.
+    struct Slot
+    {
+        uint8_t* data;  // Slot buffer pointer.
+        size_t length;  // The number of bytes read into the slot.
+    };
+
+    /// @brief Reads the source file into the ring slots ahead of the writer.
+    static void readerEntry(OS::ThreadArg);
+
+    /// @brief Reads the target file and calculates its CRC32.
+    /// @param dstFs Target file system pointer.
+    /// @param dstPath Target file path.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size.
+    /// @param crc CRC32 variable reference.
+    /// @returns True if the whole file was read. False otherwise.
+    static bool targetCrc(const FileSystem* dstFs, const char* dstPath, uint8_t* buffer, size_t size, uint32_t& crc);
+
+    static inline OS::Thread m_thread = {};              // Shared copy thread, runs the reader.
+    static inline OS::Mutex m_mutex = {};                // Serializes the copies.
+    static inline OS::EventGroup m_events = {};          // Reader and writer signals.
+    static inline bool m_isStarted = false;              // True if the copy thread is started.
+    static inline File* m_source = nullptr;              // The source file of the running copy.
+    static inline Slot m_slots[maxBuffers] = {};         // Ring slots.
+    static inline size_t m_count = 0;                    // The number of ring slots used.
+    static inline size_t m_slotSize = 0;                 // Ring slot size in bytes.
+    static inline std::atomic<size_t> m_filled = 0;      // The number of slots ever filled.
+    static inline std::atomic<size_t> m_written = 0;     // The number of slots ever written.
+    static inline std::atomic<bool> m_isEnd = false;     // True when the reader is done: end of file, error or stop.
+    static inline std::atomic<bool> m_isStopped = false; // True if the writer requested the reader to stop.
+    static inline bool m_isVerified = false;             // True if the source CRC32 is calculated.
+    static inline bool m_readFailed = false;             // True if the source file read failed.
+    static inline uint32_t m_crc = 0;                    // Source data CRC32.
+    static inline uint32_t m_readerStalls = 0;           // Reader stall counter.
+
+};
+
+/// @brief Copies a file, from one file system to another or within the same file system.
+/// @param srcFs Source file system pointer.
+/// @param srcPath Source file path.
+/// @param dstFs Target file system pointer.
+/// @param dstPath Target file path, the file is overwritten if exists.
+/// @param options Copy options, the buffer is required.
+/// @returns True if the file was copied (and verified if requested). False otherwise.
+inline bool copy(const FileSystem* srcFs, const char* srcPath, const FileSystem* dstFs, const char* dstPath, const CopyOptions& options)
+{
+    return Copy::run(srcFs, srcPath, dstFs, dstPath, options).status == Copy::done;
+}
+
+}
@@ -0,0 +1,128 @@
+/**
+ * @file        Directory.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       RAII directory enumeration API. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Directory.hpp"
+#include "Adapter.hpp"
+#include <cctype>
+#include <cstring>
+
+FS::Directory::Directory(const char *absolutePath, ...)
+    : Path(), m_handle(), m_entry(), m_pattern(), m_index(), m_status(), m_isOpen(false)
+{
+    va_list args;
+    va_start(args, absolutePath);
+    initializeWithVariadicArgs(absolutePath, args);
+    va_end(args);
+    open();
+}
+
+FS::Directory::Directory(const Path &path)
+    : Path(path), m_handle(), m_entry(), m_pattern(), m_index(), m_status(), m_isOpen(false)
+{
+    open();
+}
+
+FS::Directory::Directory(const FileSystem *fs, const char *relativePath, ...)
+    : Path(), m_handle(), m_entry(), m_pattern(), m_index(), m_status(), m_isOpen(false)
+{
+    va_list args;
+    va_start(args, relativePath);
+    initializeWithVariadicArgs(fs, relativePath, args);
+    va_end(args);
+    open();
+}
+
+FS::Directory::~Directory() { close(); }
+
+bool FS::Directory::setPattern(const char *pattern)
+{
+    if (!pattern) pattern = "";
+    size_t length = std::strlen(pattern);
+    if (length >= patternLength) return false;
+    std::memcpy(m_pattern, pattern, length + 1);
+    return true;
+}
+
+const FS::EntryInfo* FS::Directory::next()
+{
+    if (!m_isOpen) return nullptr;
+    while (true)
+    {
+        m_status = adapterOf(m_fileSystem).directoryRead(m_handle, m_entry);
+        if (m_status != OK || !m_entry.name[0]) return nullptr;
+        if (m_entry.name[0] == '.' && (!m_entry.name[1] || (m_entry.name[1] == '.' && !m_entry.name[2]))) continue;
+        if (!match(m_pattern, m_entry.name)) continue;
+        ++m_index;
+        return &m_entry;
+    }
+}
+
+size_t FS::Directory::read(EntryInfo *entries, size_t capacity)
+{
+    size_t count = 0;
+    for (const EntryInfo* entry; count < capacity && (entry = next()); ++count) entries[count] = *entry;
+    return count;
+}
+
+bool FS::Directory::skip(size_t count)
+{
+    while (count--) if (!next()) return false;
+    return true;
+}
+
+bool FS::Directory::rewind()
+{
+    close();
+    open();
+    return m_isOpen;
+}
+
+void FS::Directory::close()
+{
+    if (!m_isOpen) return;
+    adapterOf(m_fileSystem).directoryClose(m_handle);
+    m_isOpen = false;
+}
+
+bool FS::Directory::match(const char *pattern, const char *name)
+{
+    if (!pattern || !*pattern) return true;
+    const char* star = nullptr;     // The last `*` in the pattern.
+    const char* resume = nullptr;   // The name position the last `*` is currently matched up to.
+    while (*name)
+    {
+        if (*pattern == '*')
+        {
+            star = pattern++;
+            resume = name;
+            continue;
+        }
+        if (*pattern && (*pattern == '?' || *pattern == *name
+            || (!caseSensitive && std::tolower(static_cast<unsigned char>(*pattern)) == std::tolower(static_cast<unsigned char>(*name)))))
+        {
+            ++pattern;
+            ++name;
+            continue;
+        }
+        if (!star) return false;
+        pattern = star + 1; // Let the last `*` match one more character and retry.
+        name = ++resume;
+    }
+    while (*pattern == '*') ++pattern;
+    return !*pattern;
+}
+
+void FS::Directory::open()
+{
+    if (m_isOpen || !m_fileSystem || !m_fileSystem->media() || !m_path[0]) return; // Invalid path or media.
+    m_index = 0;
+    m_status = adapterOf(m_fileSystem).directoryOpen(m_handle, *this);
+    m_isOpen = m_status == OK;
+}
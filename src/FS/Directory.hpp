@@ -0,0 +1,143 @@
+/**
+ * @file        Directory.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       RAII directory enumeration API. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Path.hpp"
+
+namespace FS
+{
+
+/// @brief Provides RAII directory enumeration API.
+/// @remarks The entries are read one at a time into the entry buffer of this instance, so the stack use doesn't depend
+///          on the directory size. The "." and ".." entries are skipped. The entries can be filtered with a glob pattern.
+///          The enumeration can be continued after reading a batch, or resumed on a new instance with `skip`.
+struct Directory final : public Path
+{
+
+    static constexpr size_t patternLength = 32; // Maximum glob pattern length, including the terminator.
+
+    /// @brief Directory entry input iterator, used by the range based `for` loop.
+    class Iterator
+    {
+
+    public:
+
+        /// @brief Creates an iterator pointing at the entry.
+        /// @param directory Directory pointer.
+        /// @param entry Current entry pointer, `nullptr` for the end iterator.
+        Iterator(Directory* directory, const EntryInfo* entry) : m_directory(directory), m_entry(entry) { }
+
+        /// @returns The current entry reference.
+        inline const EntryInfo& operator*() const { return *m_entry; }
+
+        /// @returns The current entry pointer.
+        inline const EntryInfo* operator->() const { return m_entry; }
+
+        /// @brief Reads the next entry.
+        inline Iterator& operator++() { m_entry = m_directory->next(); return *this; }
+
+        /// @returns True if the iterators point at different entries.
+        inline bool operator!=(const Iterator& other) const { return m_entry != other.m_entry; }
+
+    private:
+
+        Directory* m_directory;     // Directory pointer.
+        const EntryInfo* m_entry;   // Current entry pointer, `nullptr` at the end.
+
+    };
+
+    Directory(const Directory&) = delete; // This type should not be copied.
+    Directory(Directory&&) = delete; // This type should not be moved.
+
+    /// @brief Opens a directory.
+    /// @param absolutePath Absolute path to the directory, can be the file system root.
+    /// @param ... Variadic arguments used to format the path string.
+    Directory(const char* absolutePath, ...);
+
+    /// @brief Opens a directory.
+    /// @param path Path reference.
+    Directory(const Path& path);
+
+    /// @brief Opens a directory.
+    /// @param fs File system pointer.
+    /// @param relativePath Relative path to the directory, empty for the file system root.
+    /// @param ... Variadic arguments used to format the path string.
+    Directory(const FileSystem* fs, const char* relativePath, ...);
+
+    /// @brief The directory is closed when this instance is discarded.
+    ~Directory();
+
+    /// @returns True if the directory is actually successfully open.
+    inline bool isOpen() const { return m_isOpen; }
+
+    /// @returns True if the directory is actually successfully open.
+    inline operator bool() const { return m_isOpen; }
+
+    /// @returns True if reading an entry failed.
+    inline bool hasFailed() const { return m_status != OK; }
+
+    /// @returns The number of entries returned since the directory was opened or rewound.
+    inline size_t index() const { return m_index; }
+
+    /// @brief Sets the glob pattern the following entry names are matched against.
+    /// @param pattern `*` matches any sequence, `?` matches any single character. `nullptr` matches all entries.
+    /// @returns True if set. False if the pattern is too long, the previous pattern is kept.
+    bool setPattern(const char* pattern);
+
+    /// @brief Reads the next matching entry.
+    /// @returns The entry pointer, valid until the next read. `nullptr` at the end of the directory or on error.
+    const EntryInfo* next();
+
+    /// @brief Reads a batch of the matching entries. Call again to continue.
+    /// @param entries Target array.
+    /// @param capacity Target array capacity.
+    /// @returns The number of entries read, less than the capacity at the end of the directory or on error.
+    size_t read(EntryInfo* entries, size_t capacity);
+
+    /// @brief Skips the matching entries, to resume an enumeration at the `index` saved before.
+    /// @param count The number of entries to skip.
+    /// @returns True if skipped. False if the directory ended first or an error occurred.
+    bool skip(size_t count);
+
+    /// @brief Restarts the enumeration from the first entry.
+    /// @returns True if the directory was reopened.
+    bool rewind();
+
+    /// @brief Closes the directory if it was opened.
+    void close();
+
+    /// @returns The iterator at the next matching entry.
+    inline Iterator begin() { return Iterator(this, next()); }
+
+    /// @returns The end iterator.
+    inline Iterator end() { return Iterator(this, nullptr); }
+
+    /// @brief Matches a name against a glob pattern, without recursion.
+    /// @param pattern `*` matches any sequence, `?` matches any single character. Empty or `nullptr` matches all names.
+    /// @param name Entry name.
+    /// @returns True if the name matches the pattern. Case insensitive on FAT file systems.
+    static bool match(const char* pattern, const char* name);
+
+private:
+
+    /// @brief Opens the directory if the path is resolved, the root directory is allowed.
+    void open();
+
+    DirectoryHandle m_handle;           // Directory handle.
+    EntryInfo m_entry;                  // The last entry read.
+    char m_pattern[patternLength];      // Glob pattern, empty to match all entries.
+    size_t m_index;                     // The number of entries returned.
+    Status m_status;                    // The last operation status.
+    bool m_isOpen;                      // Directory is open.
+
+};
+
+}
@@ -0,0 +1,100 @@
+/**
+ * @file        DiskImage.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       FATFS disk I/O driver for the host disk image files. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "DiskImage.hpp"
+
+#if defined(USE_FATFS) && defined(USE_DISK_IMAGE)
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool FS::DiskImage::open(BYTE lun, const char *path, DWORD sectors)
+{
+    if (lun >= units || !path) return false;
+    close(lun);
+    int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    if (sectors && ftruncate(fd, static_cast<off_t>(sectors) * sectorSize) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    struct stat info = {};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sectorSize))
+    {
+        ::close(fd);
+        return false;
+    }
+    m_files[lun] = fd + 1;
+    m_sectors[lun] = static_cast<DWORD>(info.st_size / sectorSize);
+    return true;
+}
+
+void FS::DiskImage::close(BYTE lun)
+{
+    if (lun >= units || !m_files[lun]) return;
+    ::close(m_files[lun] - 1);
+    m_files[lun] = 0;
+    m_sectors[lun] = 0;
+}
+
+DSTATUS FS::DiskImage::status(BYTE lun)
+{
+    return lun < units && m_files[lun] ? 0 : STA_NOINIT;
+}
+
+DRESULT FS::DiskImage::read(BYTE lun, BYTE *buffer, DWORD sector, UINT count)
+{
+    if (status(lun)) return RES_NOTRDY;
+    if (!buffer || !count || sector + count > m_sectors[lun] || sector + count < sector) return RES_PARERR;
+    size_t length = static_cast<size_t>(count) * sectorSize;
+    ssize_t result = pread(m_files[lun] - 1, buffer, length, static_cast<off_t>(sector) * sectorSize);
+    ++m_statistics.reads;
+    m_statistics.sectorsRead += count;
+    return result == static_cast<ssize_t>(length) ? RES_OK : RES_ERROR;
+}
+
+DRESULT FS::DiskImage::write(BYTE lun, const BYTE *buffer, DWORD sector, UINT count)
+{
+    if (status(lun)) return RES_NOTRDY;
+    if (!buffer || !count || sector + count > m_sectors[lun] || sector + count < sector) return RES_PARERR;
+    size_t length = static_cast<size_t>(count) * sectorSize;
+    ssize_t result = pwrite(m_files[lun] - 1, buffer, length, static_cast<off_t>(sector) * sectorSize);
+    ++m_statistics.writes;
+    m_statistics.sectorsWritten += count;
+    return result == static_cast<ssize_t>(length) ? RES_OK : RES_ERROR;
+}
+
+DRESULT FS::DiskImage::ioctl(BYTE lun, BYTE command, void *buffer)
+{
+    if (status(lun)) return RES_NOTRDY;
+    switch (command)
+    {
+    case CTRL_SYNC:
+        return fsync(m_files[lun] - 1) == 0 ? RES_OK : RES_ERROR;
+    case GET_SECTOR_COUNT:
+        if (!buffer) return RES_PARERR;
+        *static_cast<DWORD*>(buffer) = m_sectors[lun];
+        return RES_OK;
+    case GET_SECTOR_SIZE:
+        if (!buffer) return RES_PARERR;
+        *static_cast<WORD*>(buffer) = static_cast<WORD>(sectorSize);
+        return RES_OK;
+    case GET_BLOCK_SIZE:
+        if (!buffer) return RES_PARERR;
+        *static_cast<DWORD*>(buffer) = 1; // Erase block size in sectors, unknown.
+        return RES_OK;
+    default:
+        return RES_PARERR;
+    }
+}
+
+#endif
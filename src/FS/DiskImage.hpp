@@ -0,0 +1,115 @@
+/**
+ * @file        DiskImage.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       FATFS disk I/O driver for the host disk image files. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+
+#if defined(USE_FATFS) && defined(USE_DISK_IMAGE)
+
+#include "fatfs.h"
+#include "StaticClass.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace FS
+{
+
+/// @brief FATFS disk I/O driver (`Diskio_drvTypeDef`) backed by the host disk image files (workstation builds).
+/// @remarks Each logical unit is an image file of `_MAX_SS` byte sectors, accessed with `pread` and `pwrite`.
+///          Register it as the FATFS media driver: `MediaServices::registerType(MediaType::RAM, "0:/", DiskImage::driver())`.
+class DiskImage final
+{
+
+    STATIC(DiskImage)
+
+public:
+
+    static constexpr size_t units = 4;              // The maximal number of open images.
+    static constexpr size_t sectorSize = _MAX_SS;   // Sector size in bytes.
+
+    /// @brief Driver statistics.
+    struct Statistics
+    {
+        uint32_t reads;             // The number of read calls.
+        uint32_t writes;            // The number of write calls.
+        uint32_t sectorsRead;       // The number of sectors read.
+        uint32_t sectorsWritten;    // The number of sectors written.
+    };
+
+    /// @brief Opens or creates an image file for a logical unit.
+    /// @param lun Logical unit number.
+    /// @param path Host path of the image file.
+    /// @param sectors The image size in sectors, 0 to use the size of the existing file.
+    /// @returns True if the image is open. False otherwise.
+    static bool open(BYTE lun, const char* path, DWORD sectors = 0);
+
+    /// @brief Closes the image file of a logical unit.
+    /// @param lun Logical unit number.
+    static void close(BYTE lun);
+
+    /// @returns The disk I/O driver.
+    static inline const Diskio_drvTypeDef* driver(void) { return &m_driver; }
+
+    /// @returns Driver statistics.
+    static inline const Statistics& statistics(void) { return m_statistics; }
+
+    /// @brief Zeroes the driver statistics.
+    static inline void resetStatistics(void) { m_statistics = {}; }
+
+private:
+
+    /// @returns `STA_NOINIT` if the image of the logical unit is not open, 0 otherwise.
+    /// @param lun Logical unit number.
+    static DSTATUS status(BYTE lun);
+
+    /// @brief Reads sectors from the image file.
+    /// @param lun Logical unit number.
+    /// @param buffer Target buffer.
+    /// @param sector The first sector number.
+    /// @param count The number of sectors.
+    /// @returns Result.
+    static DRESULT read(BYTE lun, BYTE* buffer, DWORD sector, UINT count);
+
+    /// @brief Writes sectors to the image file.
+    /// @param lun Logical unit number.
+    /// @param buffer Source buffer.
+    /// @param sector The first sector number.
+    /// @param count The number of sectors.
+    /// @returns Result.
+    static DRESULT write(BYTE lun, const BYTE* buffer, DWORD sector, UINT count);
+
+    /// @brief Handles the control commands: `CTRL_SYNC`, `GET_SECTOR_COUNT`, `GET_SECTOR_SIZE` and `GET_BLOCK_SIZE`.
+    /// @param lun Logical unit number.
+    /// @param command Control command.
+    /// @param buffer Command parameter buffer.
+    /// @returns Result.
+    static DRESULT ioctl(BYTE lun, BYTE command, void* buffer);
+
+    static inline int m_files[units] = {};              // Image file descriptors plus 1, 0 if not open.
+    static inline DWORD m_sectors[units] = {};          // Image sizes in sectors.
+    static inline Statistics m_statistics = {};         // Driver statistics.
+    static inline const Diskio_drvTypeDef m_driver = {  // Driver function table.
+        status, // Initialization just tests if the image is open.
+        status,
+        read,
+#if !defined(_USE_WRITE) || _USE_WRITE == 1
+        write,
+#endif
+#if !defined(_USE_IOCTL) || _USE_IOCTL == 1
+        ioctl
+#endif
+    };
+
+};
+
+}
+
+#endif
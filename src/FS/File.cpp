@@ -10,18 +10,39 @@
 
 #include "File.hpp"
 #include "Adapter.hpp"
+#include "IOScheduler.hpp"
+#include "StatCache.hpp"
+#include "OS/Mutex.hpp"
 #include <cstdarg>
+#include <cstring>
 
-USE_ADAPTER
+static FS::FileBufferPool bufferPool;   // Static write-back buffers.
+static OS::Mutex bufferPoolMutex;       // Serializes the buffer pool access.
+
+/// @brief Tests if the file mode can create or modify the file.
+/// @param mode File mode.
+/// @returns True if the cached status of the file can change.
+static bool isModifying(FS::FileMode mode)
+{
+    using FS::FileMode;
+    return BF::isSet(FileMode::write | FileMode::openAlways | FileMode::createNew | FileMode::createAlways, mode);
+}
 
 void FS::File::open()
 {
     if (!isValid() || isOpen()) return; // Invalid path or media, obviously file not found.
-    m_status = adapter.fileOpen(*m_fileSystem->media(), m_file, m_relativePath, m_mode);
+    m_status = adapterOf(m_fileSystem).fileOpen(m_file, *this, m_mode);
     m_isOpen = m_status == OK;
+    if (isModifying(m_mode)) StatCache::invalidate(*this); // The file could be created.
 }
 
-FS::File::File(const char *absolutePath, FileMode pMode, ...) : Path(), m_mode(pMode), m_isOpen(false)
+FS::File::File()
+    : Path(), m_file(), m_mode(), m_status(), m_isOpen(false),
+    m_buffer(), m_bufferSize(), m_bufferLength(), m_bufferStart(), m_position(), m_pooled(), m_dataEnd(), m_isPreallocated(false) { }
+
+FS::File::File(const char *absolutePath, FileMode pMode, ...)
+    : Path(), m_mode(pMode), m_isOpen(false),
+    m_buffer(), m_bufferSize(), m_bufferLength(), m_bufferStart(), m_position(), m_pooled(), m_dataEnd(), m_isPreallocated(false)
 {
     va_list args;
     va_start(args, pMode);
@@ -30,7 +51,9 @@ FS::File::File(const char *absolutePath, FileMode pMode, ...) : Path(), m_mode(p
     open();
 }
 
-FS::File::File(Path &path, FileMode pMode, ...) : Path(), m_mode(pMode), m_isOpen(false)
+FS::File::File(Path &path, FileMode pMode, ...)
+    : Path(), m_mode(pMode), m_isOpen(false),
+    m_buffer(), m_bufferSize(), m_bufferLength(), m_bufferStart(), m_position(), m_pooled(), m_dataEnd(), m_isPreallocated(false)
 {
     va_list args;
     va_start(args, pMode);
@@ -40,7 +63,8 @@ FS::File::File(Path &path, FileMode pMode, ...) : Path(), m_mode(pMode), m_isOpe
 }
 
 FS::File::File(const FileSystem *fs, const char *relativePath, FileMode pMode, ...)
-    : Path(), m_mode(pMode), m_isOpen(false)
+    : Path(), m_mode(pMode), m_isOpen(false),
+    m_buffer(), m_bufferSize(), m_bufferLength(), m_bufferStart(), m_position(), m_pooled(), m_dataEnd(), m_isPreallocated(false)
 {
     va_list args;
     va_start(args, pMode);
@@ -51,29 +75,267 @@ FS::File::File(const FileSystem *fs, const char *relativePath, FileMode pMode, .
 
 FS::File::~File() { close(); }
 
+bool FS::File::open(const char *absolutePath, FileMode pMode, ...)
+{
+    va_list args;
+    va_start(args, pMode);
+    bool isAssigned = assign(absolutePath, pMode, args);
+    va_end(args);
+    if (isAssigned) open();
+    return isAssigned && m_isOpen;
+}
+
+bool FS::File::open(const FileSystem *fs, const char *relativePath, FileMode pMode, ...)
+{
+    va_list args;
+    va_start(args, pMode);
+    bool isAssigned = assign(fs, relativePath, pMode, args);
+    va_end(args);
+    if (isAssigned) open();
+    return isAssigned && m_isOpen;
+}
+
+bool FS::File::assign(const char *absolutePath, FileMode pMode, va_list args)
+{
+    if (m_isOpen) return false;
+    initializeWithVariadicArgs(absolutePath, args);
+    m_mode = pMode;
+    return isValid();
+}
+
+bool FS::File::assign(const FileSystem *fs, const char *relativePath, FileMode pMode, va_list args)
+{
+    if (m_isOpen) return false;
+    initializeWithVariadicArgs(fs, relativePath, args);
+    m_mode = pMode;
+    return isValid();
+}
+
 bool FS::File::seek(FileOffset offset)
 {
     if (!m_isOpen) return false;
-    return adapter.fileSeek(m_file, offset) == OK;
+    if (m_isPreallocated) markDataEnd(); // The data written so far is kept on close.
+    if (!m_buffer) return adapterOf(m_fileSystem).fileSeek(m_file, offset) == OK;
+    if (!flush()) return false;
+    if (adapterOf(m_fileSystem).fileSeek(m_file, offset) != OK) return false;
+    return adapterOf(m_fileSystem).fileTell(m_file, m_position) == OK; // The offset can be `offsetMax`.
+}
+
+bool FS::File::tell(FileOffset &offset)
+{
+    if (!m_isOpen) return false;
+    if (m_buffer)
+    {
+        offset = m_position;
+        return true;
+    }
+    return adapterOf(m_fileSystem).fileTell(m_file, offset) == OK;
 }
 
 FS::ReadResult FS::File::read(void *buffer, size_t size)
 {
     if (!m_isOpen || !buffer || !size) return ReadResult();
+    if (!flush()) return ReadResult(); // The pending data must be read back as written.
     size_t bytesRead;
-    return adapter.fileRead(m_file, buffer, size, bytesRead) == OK ? ReadResult(bytesRead) : ReadResult();
+    if (mediaRead(buffer, size, bytesRead) != OK) return ReadResult();
+    m_position += bytesRead;
+    return ReadResult(bytesRead);
 }
 
 bool FS::File::write(const void *buffer, size_t size)
 {
     if (!m_isOpen || !buffer || !size) return false;
-    return adapter.fileWrite(m_file, buffer, size) == OK;
+    if (!m_buffer) return mediaWrite(buffer, size) == OK;
+    auto source = static_cast<const uint8_t*>(buffer);
+    while (size)
+    {
+        if (!m_bufferLength)
+        {
+            m_bufferStart = m_position;
+            if (m_position % sectorSize == 0 && size >= m_bufferSize) // Pass whole sectors directly.
+            {
+                size_t direct = size - size % sectorSize;
+                if (mediaWrite(source, direct) != OK) return false;
+                m_position += direct;
+                source += direct;
+                size -= direct;
+                continue;
+            }
+        }
+        size_t capacity = m_bufferSize - m_bufferStart % sectorSize; // The first flush ends on a sector boundary.
+        size_t chunk = capacity - m_bufferLength;
+        if (chunk > size) chunk = size;
+        std::memcpy(m_buffer + m_bufferLength, source, chunk);
+        m_bufferLength += chunk;
+        m_position += chunk;
+        source += chunk;
+        size -= chunk;
+        if (m_bufferLength == capacity && !flush()) return false;
+    }
+    return true;
+}
+
+FS::ReadResult FS::File::readv(const IOVector *vectors, size_t count)
+{
+    if (!m_isOpen || !vectors || !count) return ReadResult();
+    if (!flush()) return ReadResult();
+    size_t bytesRead;
+    if (mediaReadv(vectors, count, bytesRead) != OK) return ReadResult();
+    m_position += bytesRead;
+    return ReadResult(bytesRead);
+}
+
+bool FS::File::writev(const IOVector *vectors, size_t count)
+{
+    if (!m_isOpen || !vectors || !count) return false;
+    if (!m_buffer) return mediaWritev(vectors, count) == OK;
+    for (size_t i = 0; i < count; ++i) // The buffer gathers the data anyway.
+        if (vectors[i].size && !write(vectors[i].data, vectors[i].size)) return false;
+    return true;
+}
+
+bool FS::File::setBuffer(void *buffer, size_t size)
+{
+    if (!m_isOpen) return false;
+    if (buffer && (size < sectorSize || size % sectorSize)) return false;
+    if (!releaseBuffer()) return false;
+    return !buffer || attachBuffer(static_cast<uint8_t*>(buffer), size);
+}
+
+bool FS::File::setBuffer()
+{
+    if (!m_isOpen) return false;
+    if (m_pooled) return flush();
+    if (!releaseBuffer()) return false;
+    bufferPoolMutex.acquire();
+    m_pooled = bufferPool.take();
+    bufferPoolMutex.release();
+    if (!m_pooled) return false;
+    if (attachBuffer(m_pooled->data, FileBuffer::size)) return true;
+    releaseBuffer();
+    return false;
+}
+
+bool FS::File::flush()
+{
+    if (!m_bufferLength) return true;
+    m_status = mediaWrite(m_buffer, m_bufferLength);
+    if (m_status != OK)
+    {
+        adapterOf(m_fileSystem).fileSeek(m_file, m_bufferStart); // Retry from the same offset on the next flush.
+        return false;
+    }
+    m_bufferLength = 0;
+    return true;
+}
+
+bool FS::File::sync()
+{
+    if (!m_isOpen || !flush()) return false;
+    IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::write);
+    m_status = adapterOf(m_fileSystem).fileSync(m_file);
+    return m_status == OK;
+}
+
+bool FS::File::truncate()
+{
+    if (!m_isOpen || !BF::isSet(FileMode::write, m_mode) || !flush()) return false;
+    {
+        IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::write);
+        m_status = adapterOf(m_fileSystem).fileTruncate(m_file);
+    }
+    if (m_status != OK) return false;
+    if (m_isPreallocated) m_dataEnd = 0; // The data ends at the current offset now.
+    return true;
+}
+
+bool FS::File::preallocate(FileOffset size, bool contiguous)
+{
+    if (!m_isOpen || !BF::isSet(FileMode::write, m_mode) || !flush()) return false;
+    FileOffset position, end;
+    if (!tell(position)) return false;
+    {
+        IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::write);
+        m_status = adapterOf(m_fileSystem).fileSize(m_file, end); // Before the expansion, that can set the size.
+        if (m_status == OK) m_status = adapterOf(m_fileSystem).fileExpand(m_file, size, contiguous);
+    }
+    if (m_status != OK) return false;
+    if (!m_isPreallocated) m_dataEnd = position > end ? position : end; // The existing content is kept on close.
+    m_isPreallocated = true;
+    return true;
 }
 
 void FS::File::close()
 {
     if (!m_isOpen) return;
-    m_status = adapter.fileClose(m_file);
+    if (m_isPreallocated) markDataEnd();
+    flush(); // The file is closed anyway, the pending data is lost if the flush failed.
+    m_bufferLength = 0;
+    releaseBuffer();
+    if (m_isPreallocated) // Releases the reserved space past the data.
+    {
+        IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::write);
+        if (adapterOf(m_fileSystem).fileSeek(m_file, m_dataEnd) == OK) adapterOf(m_fileSystem).fileTruncate(m_file);
+        m_isPreallocated = false;
+        m_dataEnd = 0;
+    }
+    m_status = adapterOf(m_fileSystem).fileClose(m_file);
     m_isOpen = m_status != OK;  // If close failed, assume the file is still open.
     if (!m_isOpen) m_file = {}; // Clear the file handle just in case.
+    if (isModifying(m_mode)) StatCache::invalidate(*this); // The size and modification time changed.
+}
+
+bool FS::File::releaseBuffer()
+{
+    if (!flush()) return false;
+    if (m_pooled)
+    {
+        bufferPoolMutex.acquire();
+        bufferPool.putBack(m_pooled);
+        bufferPoolMutex.release();
+        m_pooled = nullptr;
+    }
+    m_buffer = nullptr;
+    m_bufferSize = 0;
+    return true;
+}
+
+bool FS::File::attachBuffer(uint8_t *buffer, size_t size)
+{
+    if (adapterOf(m_fileSystem).fileTell(m_file, m_position) != OK) return false;
+    m_buffer = buffer;
+    m_bufferSize = size;
+    m_bufferLength = 0;
+    m_bufferStart = m_position;
+    return true;
+}
+
+void FS::File::markDataEnd()
+{
+    FileOffset position;
+    if (tell(position) && position > m_dataEnd) m_dataEnd = position;
+}
+
+FS::AdapterTypes::Status FS::File::mediaRead(void *buffer, size_t size, size_t &bytesRead)
+{
+    IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::read);
+    return adapterOf(m_fileSystem).fileRead(m_file, buffer, size, bytesRead);
+}
+
+FS::AdapterTypes::Status FS::File::mediaWrite(const void *buffer, size_t size)
+{
+    IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::write);
+    return adapterOf(m_fileSystem).fileWrite(m_file, buffer, size);
+}
+
+FS::AdapterTypes::Status FS::File::mediaReadv(const IOVector *vectors, size_t count, size_t &bytesRead)
+{
+    IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::read);
+    return adapterOf(m_fileSystem).fileReadv(m_file, vectors, count, bytesRead);
+}
+
+FS::AdapterTypes::Status FS::File::mediaWritev(const IOVector *vectors, size_t count)
+{
+    IOScheduler::Turn turn(m_fileSystem, m_file, IOScheduler::write);
+    return adapterOf(m_fileSystem).fileWritev(m_file, vectors, count);
 }
@@ -11,17 +11,23 @@
 #pragma once
 
 #include "Path.hpp"
+#include "FileBuffer.hpp"
 
 namespace FS
 {
 
 /// @brief Provides RAII file access API.
+/// @remarks Writes are passed to the adapter directly unless a write-back buffer is set with `setBuffer`.
+///          Buffered writes are collected and flushed in whole sectors, so the media sees aligned, large writes.
 struct File final : public Path
 {
 
     File(const File&) = delete; // This type should not be copied.
     File(File&&) = delete; // This type should not be moved.
 
+    /// @brief Creates a closed file to be opened later with `open`.
+    File();
+
     /// @brief Opens a file.
     /// @param absolutePath Absolute path to the file.
     /// @param pMode One or more flags from the `FileMode` enumeration.
@@ -44,6 +50,21 @@ struct File final : public Path
     /// @brief The file is closed when this instance is discarded.
     ~File();
 
+    /// @brief Opens a file if this instance is not open.
+    /// @param absolutePath Absolute path to the file.
+    /// @param pMode One or more flags from the `FileMode` enumeration.
+    /// @param ... Variadic arguments used to format the path string.
+    /// @returns True if opened. False otherwise.
+    bool open(const char* absolutePath, FileMode pMode, ...);
+
+    /// @brief Opens a file if this instance is not open.
+    /// @param fs File system pointer.
+    /// @param relativePath Relative path to the file.
+    /// @param pMode One or more flags from the `FileMode` enumeration.
+    /// @param ... Variadic arguments used to format the path string.
+    /// @returns True if opened. False otherwise.
+    bool open(const FileSystem* fs, const char* relativePath, FileMode pMode, ...);
+
     /// @returns True if the file is actually successfully open.
     inline bool isOpen() const { return m_isOpen; }
 
@@ -55,6 +76,11 @@ struct File final : public Path
     /// @returns True if done. False otherwise.
     bool seek(FileOffset offset);
 
+    /// @brief Gets the current read / write pointer offset, including the buffered data.
+    /// @param offset Offset reference to set.
+    /// @returns True if done. False otherwise.
+    bool tell(FileOffset& offset);
+
     /// @brief Reads the data from the file.
     /// @param buffer Buffer pointer.
     /// @param size Number of bytes requested.
@@ -84,18 +110,131 @@ struct File final : public Path
     /// @returns True if written successfully. False otherwise.
     template<typename T> bool write(T& data) { return write(&data, sizeof(data)); }
 
-    /// @brief Closes the file if it was opened.
+    /// @brief Reads the data from the file into consecutive buffers.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @returns Total number of bytes read or an empty value if error occurred.
+    ReadResult readv(const IOVector* vectors, size_t count);
+
+    /// @brief Writes the data from consecutive buffers to the file, without copying them into a single buffer.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @returns True if written successfully. False otherwise.
+    bool writev(const IOVector* vectors, size_t count);
+
+    /// @brief Sets a caller provided write-back buffer. Flushes and releases the current buffer first.
+    /// @param buffer Buffer pointer, `nullptr` to make the writes unbuffered again.
+    /// @param size Buffer size in bytes, must be a multiple of the `sectorSize`.
+    /// @returns True if set. False if the file is not open, the size is invalid or the pending data could not be flushed.
+    bool setBuffer(void* buffer, size_t size);
+
+    /// @brief Sets a write-back buffer taken from the static pool (`WTK_FS_FILE_BUFFERS` of `WTK_FS_FILE_BUFFER_SIZE` bytes).
+    /// @returns True if set. False if the file is not open, the pool is exhausted or the pending data could not be flushed.
+    bool setBuffer();
+
+    /// @returns True if the writes are buffered.
+    inline bool isBuffered() const { return m_buffer != nullptr; }
+
+    /// @brief Writes the buffered data to the file.
+    /// @returns True if done or there was nothing to write. False if the write failed, the data is kept in the buffer.
+    bool flush();
+
+    /// @brief Flushes the buffered data and commits the file data and size to the media, so they survive a power loss.
+    /// @returns True if done. False if the flush or the media commit failed.
+    bool sync();
+
+    /// @brief Flushes the buffered data and truncates the file at the current offset.
+    /// @returns True if done. False otherwise.
+    bool truncate();
+
+    /// @brief Reserves the media space for the file, so the following writes don't allocate clusters.
+    /// @remarks Call it right after creating the file, or at the end of a file opened for appending.
+    ///          The reserved space past the written data, or past the original file end if it was further, is released when the file is closed.
+    ///          On FATFS a contiguous area can only be reserved for an empty file. Combine with `setBuffer` for streaming.
+    /// @param size The total file size in bytes to reserve.
+    /// @param contiguous True to require a single run of consecutive clusters, false to accept any clusters.
+    /// @returns True if reserved. False if the file is not open for writing, or the media has no (contiguous) space left.
+    bool preallocate(FileOffset size, bool contiguous = true);
+
+    /// @returns True if the media space was reserved with `preallocate`.
+    inline bool isPreallocated() const { return m_isPreallocated; }
+
+    /// @brief Flushes the buffered data and closes the file if it was opened.
     void close();
 
 private:
 
+    friend class IOService; // Opens the files asynchronously.
+
+    /// @brief Sets the path and the mode of a file that is not open.
+    /// @param absolutePath Absolute path to the file.
+    /// @param pMode One or more flags from the `FileMode` enumeration.
+    /// @param args Variadic arguments used to format the path string.
+    /// @returns True if the path is valid and the file is not open.
+    bool assign(const char* absolutePath, FileMode pMode, va_list args);
+
+    /// @brief Sets the path and the mode of a file that is not open.
+    /// @param fs File system pointer.
+    /// @param relativePath Relative path to the file.
+    /// @param pMode One or more flags from the `FileMode` enumeration.
+    /// @param args Variadic arguments used to format the path string.
+    /// @returns True if the path is valid and the file is not open.
+    bool assign(const FileSystem* fs, const char* relativePath, FileMode pMode, va_list args);
+
     /// @brief Opens or creates the file on the media if the path is valid and the media is mounted in the `FileSystemTable`.
     void open();
 
+    /// @brief Flushes the pending data and detaches the current buffer, returning it to the pool if taken from it.
+    /// @returns True if done. False if the pending data could not be flushed, the buffer is kept.
+    bool releaseBuffer();
+
+    /// @brief Attaches a write-back buffer at the current file offset.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size in bytes.
+    /// @returns True if done. False if the current file offset could not be read.
+    bool attachBuffer(uint8_t* buffer, size_t size);
+
+    /// @brief Moves the end of the written data to the current offset, if it is past it.
+    void markDataEnd();
+
+    /// @brief Reads from the media in the `IOScheduler` turn.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes requested.
+    /// @param bytesRead Number of bytes read reference.
+    /// @returns Adapter status.
+    Status mediaRead(void* buffer, size_t size, size_t& bytesRead);
+
+    /// @brief Writes to the media in the `IOScheduler` turn.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes to write.
+    /// @returns Adapter status.
+    Status mediaWrite(const void* buffer, size_t size);
+
+    /// @brief Reads from the media into consecutive buffers in the `IOScheduler` turn.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @param bytesRead Number of bytes read reference.
+    /// @returns Adapter status.
+    Status mediaReadv(const IOVector* vectors, size_t count, size_t& bytesRead);
+
+    /// @brief Writes to the media from consecutive buffers in the `IOScheduler` turn.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @returns Adapter status.
+    Status mediaWritev(const IOVector* vectors, size_t count);
+
     FileControlBlock m_file;  // File handle.
     FileMode m_mode;    // File mode.
     Status m_status;    // File status.
     bool m_isOpen;      // File is open.
+    uint8_t* m_buffer;          // Write-back buffer, `nullptr` if unbuffered.
+    size_t m_bufferSize;        // Write-back buffer size in bytes.
+    size_t m_bufferLength;      // The number of pending bytes in the buffer.
+    FileOffset m_bufferStart;   // The file offset of the first pending byte.
+    FileOffset m_position;      // The file offset including the pending bytes.
+    FileBuffer* m_pooled;       // The buffer taken from the pool, `nullptr` if not taken.
+    FileOffset m_dataEnd;       // The end of the written data in a preallocated file.
+    bool m_isPreallocated;      // The media space was reserved, the file is truncated on close.
 
 };
 
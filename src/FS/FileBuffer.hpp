@@ -0,0 +1,58 @@
+/**
+ * @file        FileBuffer.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Pre-allocated write-back buffers for the `FS::File` instances. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "AdapterTypes.hpp"
+#include "Pool.hpp"
+
+#ifndef WTK_FS_FILE_BUFFERS
+#define WTK_FS_FILE_BUFFERS 2
+#endif
+
+#ifndef WTK_FS_FILE_BUFFER_SIZE
+#define WTK_FS_FILE_BUFFER_SIZE 4096
+#endif
+
+namespace FS
+{
+
+/// @brief A write-back buffer for one open file.
+struct FileBuffer final
+{
+
+    static constexpr size_t size = WTK_FS_FILE_BUFFER_SIZE; // Buffer size in bytes.
+    static_assert(size && size % AdapterTypes::sectorSize == 0, "WTK_FS_FILE_BUFFER_SIZE must be a multiple of the sector size.");
+
+    alignas(32) uint8_t data[size]; // Buffer data, aligned for DMA transfers.
+    bool isTaken;                   // True if the buffer is used by a file.
+
+};
+
+/// @brief Provides pre-allocated file write-back buffers.
+/// @remarks Not synchronized, the caller must serialize `take` and `putBack` calls.
+class FileBufferPool final : public Pool<WTK_FS_FILE_BUFFERS, FileBuffer>
+{
+
+public:
+
+    /// @param item Item pointer.
+    /// @returns True if the item is available. False otherwise.
+    bool isAvailable(FileBuffer* item) const override { return !item->isTaken; }
+
+    /// @brief Sets the item as available.
+    /// @param item Item pointer.
+    /// @param value 1: Available (default), 0: Taken.
+    void setAvailable(FileBuffer* item, bool value = 1) override { item->isTaken = !value; }
+
+};
+
+}
@@ -10,19 +10,21 @@
 
 #include "FileSystem.hpp"
 #include "Media.hpp"
+#include "Adapter.hpp"
 #include <cstring>
 #include <cstdarg>
 #include <utility>
 
-const FS::FileSystem* FS::FileSystemTable::add(const char* root, Media* media)
+const FS::FileSystem* FS::FileSystemTable::add(const char* root, Media* media, const IAdapterMethods* adapter)
 {
-    if (!root || !media) return nullptr;
+    if (!root || !media || (!WTK_FS_ADAPTER_DISPATCH && adapter)) return nullptr;
     auto existingEntry = find(root);
     if (existingEntry) return existingEntry->m_media == media ? existingEntry : nullptr;
     auto entry = getFree();
     if (!entry) return nullptr;
     entry->m_root = root;
     entry->m_media = media;
+    entry->m_adapter = adapter;
     auto configuration = MediaServices::getConfiguration(root);
     if (!configuration) return nullptr;
     entry->m_type = configuration->type;
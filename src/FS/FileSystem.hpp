@@ -17,20 +17,24 @@
 namespace FS
 {
 
+class IAdapterMethods;
+
 /// @brief Contains file system metadata.
 struct FileSystem final : public AdapterTypes
 {
 
     /// @brief Creates an empty file system target definition.
-    FileSystem() : m_root(), m_media() { }
+    FileSystem() : m_root(), m_media(), m_adapter() { }
 
     /// @brief Creates a file system target definition.
     /// @param root The root path of the file system.
     /// @param media Media handle reference.
-    FileSystem(const char* root, Media& media) : m_root(root), m_media(&media) { }
+    /// @param adapter Adapter pointer, `nullptr` for the compiled in adapter.
+    FileSystem(const char* root, Media& media, const IAdapterMethods* adapter = nullptr)
+        : m_root(root), m_media(&media), m_adapter(adapter) { }
 
     /// @brief Clears the file system target definition making it empty for reuse.
-    inline void clear(void) { m_root = nullptr; m_media = nullptr; m_type = MediaType::NONE; }
+    inline void clear(void) { m_root = nullptr; m_media = nullptr; m_adapter = nullptr; m_type = MediaType::NONE; }
 
     /// @returns The file system root path.
     inline const char* root() const { return m_root; }
@@ -38,6 +42,10 @@ struct FileSystem final : public AdapterTypes
     /// @returns The file system media structure pointer.
     inline Media* media() const { return m_media; }
 
+    /// @returns The adapter set for this file system, `nullptr` for the compiled in adapter.
+    /// @remarks Used only when `WTK_FS_ADAPTER_DISPATCH` is set, otherwise all calls go to the compiled in adapter.
+    inline const IAdapterMethods* adapter() const { return m_adapter; }
+
     /// @returns True if the file system is actually mounted.
     inline bool isMounted() const { return !!m_root && !!m_media; }
 
@@ -45,9 +53,10 @@ private:
 friend class FileSystemTable;
 friend class MediaServices;
 
-    const char* m_root; // File system target root path pointer.
-    Media* m_media;     // File system media handle pointer.
-    MediaType m_type;   // Media type enumeration member.
+    const char* m_root;                 // File system target root path pointer.
+    Media* m_media;                     // File system media handle pointer.
+    const IAdapterMethods* m_adapter;   // File system adapter pointer, `nullptr` for the compiled in adapter.
+    MediaType m_type;                   // Media type enumeration member.
 
 };
 
@@ -64,8 +73,9 @@ public:
     /// @brief Adds a new mount point to the mount table.
     /// @param root File system root path pointer.
     /// @param media Media structure pointer.
+    /// @param adapter Adapter pointer, `nullptr` for the compiled in adapter. Requires `WTK_FS_ADAPTER_DISPATCH` to be set.
     /// @returns File system target pointer if successfully added, `nullptr` otherwise.
-    static const FileSystem* add(const char* root, Media* media);
+    static const FileSystem* add(const char* root, Media* media, const IAdapterMethods* adapter = nullptr);
 
     /// @brief Finds the file system target matching the root of the path.
     /// @param path An absolute path with the file system root to match.
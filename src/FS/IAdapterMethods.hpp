@@ -13,6 +13,7 @@
 #include "DateTimeEx.hpp"
 #include "AdapterTypes.hpp"
 #include "FileSystem.hpp"
+#include "Path.hpp"
 
 #define FS_MOUNT_MTAB_FULL          ((FS::AdapterTypes::Status)0xfff0)  // The file system table is full.
 #define FS_MOUNT_CONFLICT           ((FS::AdapterTypes::Status)0xfff1)  // A file system already mounted for a different media.
@@ -31,45 +32,39 @@ class IAdapterMethods : public AdapterTypes
 public:
 
     /// @brief Finds the directory entry that matches the path.
-    /// @param media Media structure reference.
     /// @param path File or directory path.
     /// @param entry Directory entry reference.
     /// @returns Status.
-    virtual Status find(Media& media, const char* path, DirectoryEntry& entry) const = 0;
+    virtual Status find(const Path& path, DirectoryEntry& entry) const = 0;
 
     /// @brief Gets the file or directory creation time.
-    /// @param media Media structure reference.
     /// @param path File or directory path.
     /// @param dateTime `DateTime` structure reference.
     /// @returns Status.
-    virtual Status created(Media& media, const char* path, DateTime& dateTime) const = 0;
+    virtual Status created(const Path& path, DateTime& dateTime) const = 0;
 
     /// @brief Gets the file or directory last modification time.
-    /// @param media Media structure reference.
     /// @param path File or directory path.
     /// @param dateTime `DateTime` structure reference.
     /// @returns Status.
-    virtual Status modified(Media& media, const char* path, DateTime& dateTime) const = 0;
+    virtual Status modified(const Path& path, DateTime& dateTime) const = 0;
 
     /// @brief Creates a file.
-    /// @param media Media structure reference.
     /// @param path File path.
     /// @returns Status.
-    virtual Status fileCreate(Media& media, const char* path) const = 0;
+    virtual Status fileCreate(const Path& path) const = 0;
 
     /// @brief Tests if a file exist on the media.
-    /// @param media Media structure reference.
     /// @param path File path.
     /// @returns Status.
-    virtual Status fileExists(Media& media, const char* path) const = 0;
+    virtual Status fileExists(const Path& path) const = 0;
 
     /// @brief Opens a file.
-    /// @param media Media structure reference.
     /// @param file File handle reference.
     /// @param path A path to the file relative to the file system root.
     /// @param mode File opening flags.
     /// @returns Status.
-    virtual Status fileOpen(Media& media, FileControlBlock& file, const char* path, FileMode mode = FileMode::read) const = 0;
+    virtual Status fileOpen(FileControlBlock& file, const Path& path, FileMode mode = FileMode::read) const = 0;
 
     /// @brief Moves the file pointer to the specified offset.
     /// @param file File handle reference.
@@ -77,6 +72,12 @@ public:
     /// @returns Status.
     virtual Status fileSeek(FileControlBlock& file, FileOffset offset) const = 0;
 
+    /// @brief Gets the current file pointer.
+    /// @param file File handle reference.
+    /// @param offset Position within the file variable reference.
+    /// @returns Status.
+    virtual Status fileTell(FileControlBlock& file, FileOffset& offset) const = 0;
+
     /// @brief Reads data from a file.
     /// @param file File handle reference.
     /// @param buffer Buffer pointer.
@@ -92,48 +93,124 @@ public:
     /// @returns Status.
     virtual Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const = 0;
 
+    /// @brief Reads data from a file into consecutive buffers. Emulated with `fileRead` unless overridden.
+    /// @param file File handle reference.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @param bytesRead Number of bytes read variable reference.
+    /// @returns Status.
+    virtual Status fileReadv(FileControlBlock& file, const IOVector* vectors, size_t count, size_t& bytesRead) const
+    {
+        bytesRead = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t n = 0;
+            Status result = fileRead(file, vectors[i].data, vectors[i].size, n);
+            bytesRead += n;
+            if (result != OK) return result;
+            if (n < vectors[i].size) break; // End of file.
+        }
+        return OK;
+    }
+
+    /// @brief Writes data from consecutive buffers to a file. Emulated with `fileWrite` unless overridden.
+    /// @param file File handle reference.
+    /// @param vectors Buffers array.
+    /// @param count The number of buffers.
+    /// @returns Status.
+    virtual Status fileWritev(FileControlBlock& file, const IOVector* vectors, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!vectors[i].size) continue;
+            Status result = fileWrite(file, vectors[i].data, vectors[i].size);
+            if (result != OK) return result;
+        }
+        return OK;
+    }
+
+    /// @brief Gets the current file size, including the data not synced yet. Not supported unless overridden.
+    /// @param file File handle reference.
+    /// @param size File size variable reference.
+    /// @returns Status.
+    virtual Status fileSize(FileControlBlock&, FileOffset&) const { return FS_NEGATIVE; }
+
+    /// @brief Reserves the media space for the file data, so the following writes don't allocate it. Not supported unless overridden.
+    /// @param file File handle reference.
+    /// @param size The file size in bytes to reserve the space for.
+    /// @param contiguous True to require a single contiguous area.
+    /// @returns Status.
+    virtual Status fileExpand(FileControlBlock&, FileOffset, bool) const { return FS_NEGATIVE; }
+
+    /// @brief Truncates the file at the current file pointer, releasing the space reserved past it. Not supported unless overridden.
+    /// @param file File handle reference.
+    /// @returns Status.
+    virtual Status fileTruncate(FileControlBlock&) const { return FS_NEGATIVE; }
+
+    /// @brief Writes the cached file data and the directory entry to the media. Not supported unless overridden.
+    /// @param file File handle reference.
+    /// @returns Status.
+    virtual Status fileSync(FileControlBlock&) const { return FS_NEGATIVE; }
+
     /// @brief Closes a file.
     /// @param file File handle reference.
     /// @returns Status.
     virtual Status fileClose(FileControlBlock& file) const = 0;
 
     /// @brief Renames a file on the media.
-    /// @param media Media structure reference.
     /// @param oldName Old file name.
     /// @param newName New file name.
     /// @returns Status.
-    virtual Status fileRename(Media& media, const char* oldName, const char* newName) const = 0;
+    virtual Status fileRename(const Path& oldName, const Path& newName) const = 0;
 
     /// @brief Deletes a file from the media.
-    /// @param media Media structure reference.
     /// @param path File name.
     /// @returns Status.
-    virtual Status fileDelete(Media& media, const char* path) const = 0;
+    virtual Status fileDelete(const Path& path) const = 0;
 
     /// @brief Creates a directory on the media.
-    /// @param media Media structure reference.
     /// @param path Directory name.
     /// @returns Status.
-    virtual Status directoryCreate(Media& media, const char* path) const = 0;
+    virtual Status directoryCreate(const Path& path) const = 0;
 
     /// @brief Tests if a directory exists on the media.
-    /// @param media Media structure reference.
     /// @param path Directory name.
     /// @returns Status.
-    virtual Status directoryExists(Media& media, const char* path) const = 0;
+    virtual Status directoryExists(const Path& path) const = 0;
 
     /// @brief Renames a directory on the media.
-    /// @param media Media structure reference.
     /// @param oldName Old directory name.
     /// @param newName New directory name.
     /// @returns Status.
-    virtual Status directoryRename(Media& media, const char* oldName, const char* newName) const = 0;
+    virtual Status directoryRename(const Path& oldName, const Path& newName) const = 0;
 
     /// @brief Deletes a directory from the media.
-    /// @param media Media structure reference.
     /// @param path Directory name.
     /// @returns Status.
-    virtual Status directoryDelete(Media& media, const char* path) const = 0;
+    virtual Status directoryDelete(const Path& path) const = 0;
+
+    /// @brief Opens a directory for the entry enumeration.
+    /// @param directory Directory handle reference.
+    /// @param path Directory path, can be the file system root.
+    /// @returns Status.
+    virtual Status directoryOpen(DirectoryHandle& directory, const Path& path) const = 0;
+
+    /// @brief Reads the next directory entry.
+    /// @param directory Directory handle reference.
+    /// @param entry Entry information reference. The name is set empty at the end of the directory.
+    /// @returns Status.
+    virtual Status directoryRead(DirectoryHandle& directory, EntryInfo& entry) const = 0;
+
+    /// @brief Closes the directory handle.
+    /// @param directory Directory handle reference.
+    /// @returns Status.
+    virtual Status directoryClose(DirectoryHandle& directory) const = 0;
+
+protected:
+
+    /// @returns The media the path resolves to.
+    /// @param path A path resolved to a mounted file system.
+    static inline Media& mediaOf(const Path& path) { return *path.fileSystem()->media(); }
 
 };
 
@@ -0,0 +1,98 @@
+/**
+ * @file        IOScheduler.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Per media ordering of the concurrent file data transfers. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "IOScheduler.hpp"
+#include "Adapter.hpp"
+
+/// @returns True if the sequence number `a` was assigned before `b`.
+static inline bool isBefore(uint32_t a, uint32_t b) { return static_cast<int32_t>(a - b) < 0; }
+
+/// @returns True if the (file, offset) key of `a` is below the key of `b`.
+template<typename T> static inline bool isBelow(const T& a, const T& b)
+{
+    if (a.file != b.file) return reinterpret_cast<uintptr_t>(a.file) < reinterpret_cast<uintptr_t>(b.file);
+    return a.offset < b.offset;
+}
+
+int FS::IOScheduler::acquire(const FileSystem *fs, FileControlBlock &file, Kind kind)
+{
+    FileOffset offset = 0;
+    adapterOf(fs).fileTell(file, offset); // The ordering key only, the transfer reports its own errors.
+    const void* media = fs ? fs->media() : nullptr;
+    m_mutex.acquire();
+    Ticket* ticket = nullptr;
+    bool isBusy = false;
+    for (auto& other : m_tickets)
+    {
+        if (!ticket && other.state == available) ticket = &other;
+        else if (other.state != available && other.media == media) isBusy = true;
+    }
+    if (!ticket)
+    {
+        ++m_statistics.overflows;
+        m_mutex.release();
+        return -1; // Not tracked, the adapter serializes it anyway.
+    }
+    OS::TickCount start = OS::getTick();
+    *ticket = { isBusy ? waiting : running, kind, 0, m_sequence++, media, &file, offset, start };
+    if (isBusy) ++m_statistics.queued; else ++m_statistics.direct;
+    m_mutex.release();
+    int slot = static_cast<int>(ticket - m_tickets);
+    if (!isBusy) return slot;
+    m_events.wait(1u << slot); // Set by the transfer passing the media.
+    OS::TickCount elapsed = OS::getTick() - start;
+    m_mutex.acquire();
+    if (elapsed > m_statistics.maxWait) m_statistics.maxWait = elapsed;
+    m_mutex.release();
+    return slot;
+}
+
+void FS::IOScheduler::release(int slot)
+{
+    m_mutex.acquire();
+    Ticket& ticket = m_tickets[slot];
+    ticket.state = available;
+    Ticket* successor = next(ticket);
+    if (successor) successor->state = running;
+    m_mutex.release();
+    if (successor) m_events.signal(1u << (successor - m_tickets));
+}
+
+FS::IOScheduler::Ticket *FS::IOScheduler::next(const Ticket &head)
+{
+    Ticket* oldest = nullptr;   // The first arrived.
+    Ticket* aged = nullptr;     // The first arrived of the passed over too many times.
+    Ticket* best = nullptr;     // The first in the priority and the elevator order.
+    for (auto& ticket : m_tickets)
+    {
+        if (ticket.state != waiting || ticket.media != head.media) continue;
+        if (!oldest || isBefore(ticket.sequence, oldest->sequence)) oldest = &ticket;
+        if (ticket.passed >= aging && (!aged || isBefore(ticket.sequence, aged->sequence))) aged = &ticket;
+        if (!best) best = &ticket;
+        else if (ticket.kind != best->kind)
+        {
+            if (ticket.kind < best->kind) best = &ticket;
+        }
+        else
+        {
+            bool isAhead = !isBelow(ticket, head);
+            bool isBestAhead = !isBelow(*best, head);
+            if (isAhead != isBestAhead ? isAhead : isBelow(ticket, *best)) best = &ticket;
+        }
+    }
+    Ticket* selected = aged ? aged : best;
+    if (!selected) return nullptr;
+    if (aged) ++m_statistics.aged;
+    else if (selected != oldest) ++m_statistics.reordered;
+    for (auto& ticket : m_tickets) // The older transfers are passed over.
+        if (ticket.state == waiting && ticket.media == head.media && isBefore(ticket.sequence, selected->sequence) && ticket.passed < UINT8_MAX)
+            ++ticket.passed;
+    return selected;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file        IOScheduler.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Per media ordering of the concurrent file data transfers. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "FileSystem.hpp"
+#include "StaticClass.hpp"
+#include "OS/EventGroup.hpp"
+#include "OS/Mutex.hpp"
+#include <cstdint>
+
+#ifndef WTK_FS_IO_SCHEDULER
+#define WTK_FS_IO_SCHEDULER 0
+#endif
+
+#ifndef WTK_FS_IO_SCHEDULER_AGING
+#define WTK_FS_IO_SCHEDULER_AGING 4
+#endif
+
+namespace FS
+{
+
+/// @brief Orders the data transfers of the threads sharing a media, one transfer at a time per media.
+/// @remarks Every `File` read, write, flush, sync, truncate and preallocation takes a `Turn` before it calls the adapter, so the synchronous API
+///          and the `IOService` workers are scheduled the same way. A thread finding the media idle goes straight on.
+///          When the media is busy the transfers wait, and the finishing one passes the media to the next:
+///          reads before writes, then in the ascending (file, offset) order from the finished transfer (C-SCAN),
+///          so the transfers of the same file follow each other. A transfer passed over `WTK_FS_IO_SCHEDULER_AGING`
+///          times is served first, so the writes are not starved by a steady stream of reads.
+///          The scheduler only orders the transfers. Merging the adjacent requests into one vectored transfer is done
+///          by the `IOService` queue, the synchronous `File` calls are never merged.
+///          Disabled when `WTK_FS_IO_SCHEDULER` is 0 (default), the `Turn` is then compiled out.
+class IOScheduler final : public AdapterTypes
+{
+
+    STATIC(IOScheduler)
+
+public:
+
+    static constexpr size_t capacity = WTK_FS_IO_SCHEDULER;         // The maximal number of transfers tracked at once.
+    static constexpr uint8_t aging = WTK_FS_IO_SCHEDULER_AGING;     // The number of times a transfer can be passed over.
+
+    static_assert(capacity <= 24, "WTK_FS_IO_SCHEDULER is limited by the event group bits to 24");
+
+    /// @brief Transfer kind, also the priority class.
+    enum Kind : uint8_t
+    {
+        read,   // Latency sensitive, served first.
+        write   // Bulk, served when no read waits or when aged.
+    };
+
+    /// @brief Scheduler statistics.
+    struct Statistics
+    {
+        uint32_t direct;            // The number of transfers started on an idle media.
+        uint32_t queued;            // The number of transfers that waited for the media.
+        uint32_t reordered;         // The number of transfers started before an older waiting one.
+        uint32_t aged;              // The number of transfers started because they were passed over too many times.
+        uint32_t overflows;         // The number of transfers not tracked, because all slots were taken.
+        OS::TickCount maxWait;      // The longest wait for the media in system ticks.
+    };
+
+    /// @brief Holds the media for one data transfer, for the lifetime of the instance.
+    class Turn final
+    {
+
+    public:
+
+        /// @brief Waits for the media turn of a transfer at the current file offset.
+        /// @param fs File system pointer.
+        /// @param file File handle reference.
+        /// @param kind Transfer kind.
+        Turn(const FileSystem* fs, FileControlBlock& file, Kind kind) : m_slot(-1)
+        {
+            if constexpr (capacity > 0) m_slot = acquire(fs, file, kind);
+        }
+
+        /// @brief Passes the media to the next waiting transfer.
+        ~Turn()
+        {
+            if constexpr (capacity > 0) if (m_slot >= 0) release(m_slot);
+        }
+
+        Turn(const Turn&) = delete;
+        Turn& operator=(const Turn&) = delete;
+
+    private:
+
+        int m_slot; // The ticket slot index, -1 if not tracked.
+
+    };
+
+    /// @returns True if the scheduler is compiled in.
+    static constexpr bool isEnabled(void) { return capacity > 0; }
+
+    /// @returns Scheduler statistics.
+    static inline const Statistics& statistics(void) { return m_statistics; }
+
+private:
+
+    /// @brief Ticket slot state.
+    enum State : uint8_t
+    {
+        available,  // The slot is not used.
+        waiting,    // The transfer waits for the media.
+        running     // The transfer holds the media.
+    };
+
+    /// @brief Transfer ticket.
+    struct Ticket
+    {
+        State state;            // Slot state.
+        Kind kind;              // Transfer kind.
+        uint8_t passed;         // The number of times the transfer was passed over.
+        uint32_t sequence;      // Arrival order.
+        const void* media;      // Target media.
+        const void* file;       // File handle address, the first ordering key.
+        FileOffset offset;      // File offset, the second ordering key.
+        OS::TickCount start;    // Arrival time.
+    };
+
+    /// @brief Takes a ticket and waits for the media turn.
+    /// @param fs File system pointer.
+    /// @param file File handle reference.
+    /// @param kind Transfer kind.
+    /// @returns Ticket slot index, -1 if all slots are taken.
+    static int acquire(const FileSystem* fs, FileControlBlock& file, Kind kind);
+
+    /// @brief Releases the ticket and starts the next waiting transfer on the same media.
+    /// @param slot Ticket slot index.
+    static void release(int slot);
+
+    /// @brief Selects the next transfer waiting for the media. Call with the mutex held.
+    /// @param head The finished transfer ticket, the elevator position.
+    /// @returns The selected ticket or `nullptr` if no transfer waits for the media.
+    static Ticket* next(const Ticket& head);
+
+    static inline Ticket m_tickets[capacity > 0 ? capacity : 1] = {};   // Ticket slots.
+    static inline OS::Mutex m_mutex = {};                               // Serializes the ticket access.
+    static inline OS::EventGroup m_events = {};                         // One turn bit per ticket slot.
+    static inline uint32_t m_sequence = 0;                              // The next arrival sequence number.
+    static inline Statistics m_statistics = {};                         // Scheduler statistics.
+
+};
+
+}
@@ -0,0 +1,238 @@
+/**
+ * @file        IOService.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Asynchronous file I/O service executing file operations on background threads. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "IOService.hpp"
+#include "OS/AppThread.hpp"
+#include <cstdarg>
+
+static constexpr OS::EventFlags wakeBit = 1; // Worker wake flag.
+
+/// @returns True if the sequence number `a` was assigned before `b`.
+static inline bool isBefore(uint32_t a, uint32_t b) { return static_cast<int32_t>(a - b) < 0; }
+
+AsyncResult *FS::IOService::openAsync(File &file, const char *absolutePath, FileMode mode, OS::ThreadContext context)
+{
+    if (!assign(file, absolutePath, mode))
+    {
+        ++m_statistics.rejected;
+        return nullptr;
+    }
+    auto result = Async::createResult();
+    if (submit(opOpen, file, nullptr, 0, result, context)) return result;
+    Async::discardResult(result);
+    return nullptr;
+}
+
+AsyncResult *FS::IOService::closeAsync(File &file, OS::ThreadContext context)
+{
+    auto result = Async::createResult();
+    if (submit(opClose, file, nullptr, 0, result, context)) return result;
+    Async::discardResult(result);
+    return nullptr;
+}
+
+AsyncResultT<size_t> *FS::IOService::readAsync(File &file, void *buffer, size_t size, OS::ThreadContext context)
+{
+    if (!buffer || !size)
+    {
+        ++m_statistics.rejected;
+        return nullptr;
+    }
+    auto result = Async::createResult<size_t>();
+    if (submit(opRead, file, buffer, size, result, context)) return result;
+    Async::discardResult(result);
+    return nullptr;
+}
+
+AsyncResult *FS::IOService::writeAsync(File &file, const void *buffer, size_t size, OS::ThreadContext context)
+{
+    if (!buffer || !size)
+    {
+        ++m_statistics.rejected;
+        return nullptr;
+    }
+    auto result = Async::createResult();
+    if (submit(opWrite, file, const_cast<void*>(buffer), size, result, context)) return result;
+    Async::discardResult(result);
+    return nullptr;
+}
+
+size_t FS::IOService::pending(void)
+{
+    m_mutex.acquire();
+    size_t count = 0;
+    for (const auto& request : m_requests) if (request.state != available) ++count;
+    m_mutex.release();
+    return count;
+}
+
+bool FS::IOService::submit(Operation operation, File &file, void *buffer, size_t size, void *result, OS::ThreadContext context)
+{
+    if (!result) return false;
+    m_mutex.acquire();
+    if (!m_isStarted)
+    {
+        for (auto& thread : m_threads) thread.start(workerEntry, "IOService", OS::ThreadPriority::belowNormal);
+        m_isStarted = true;
+    }
+    Request* slot = nullptr;
+    for (auto& request : m_requests) if (request.state == available) { slot = &request; break; }
+    if (slot)
+    {
+        *slot = { queued, operation, context, m_sequence++, &file,
+                  file.fileSystem() ? file.fileSystem()->media() : nullptr, buffer, size, result, 0, false, nullptr };
+        ++m_statistics.submitted;
+    }
+    else ++m_statistics.rejected;
+    m_mutex.release();
+    if (slot) m_wake.signal(wakeBit);
+    return slot != nullptr;
+}
+
+FS::IOService::Request *FS::IOService::claim(void)
+{
+    Request* oldest = nullptr;
+    for (auto& request : m_requests)
+    {
+        if (request.state != queued || (oldest && isBefore(oldest->sequence, request.sequence))) continue;
+        bool isBlocked = false;
+        size_t inFlight = 0;
+        for (const auto& other : m_requests)
+        {
+            if (other.state == running && other.media == request.media) ++inFlight;
+            if (other.file == request.file && (other.state == running ||
+                (other.state == queued && isBefore(other.sequence, request.sequence)))) isBlocked = true; // Keep the order per file.
+        }
+        if (!isBlocked && inFlight < maxInFlight) oldest = &request;
+    }
+    if (!oldest) return nullptr;
+    oldest->state = running;
+    if (oldest->operation != opRead && oldest->operation != opWrite) return oldest;
+    Request* last = oldest;
+    for (size_t count = 1; count < maxMerge; ++count) // The next queued requests of the file, while the operation is the same.
+    {
+        Request* follower = nullptr;
+        for (auto& request : m_requests)
+            if (request.state == queued && request.file == oldest->file && (!follower || isBefore(request.sequence, follower->sequence)))
+                follower = &request;
+        if (!follower || follower->operation != oldest->operation) break;
+        follower->state = running;
+        last->next = follower;
+        last = follower;
+        ++m_statistics.merged;
+    }
+    return oldest;
+}
+
+void FS::IOService::execute(Request &request)
+{
+    OS::TickCount begin = OS::getTick();
+    File& file = *request.file;
+    Request* chain[maxMerge];
+    IOVector vectors[maxMerge];
+    size_t count = 0;
+    for (Request* r = &request; r && count < maxMerge; r = r->next)
+    {
+        chain[count] = r;
+        vectors[count++] = { r->buffer, r->size };
+    }
+    switch (request.operation)
+    {
+    case opOpen:
+        file.open();
+        request.isOk = file.isOpen();
+        break;
+    case opClose:
+        file.close();
+        request.isOk = !file.isOpen();
+        break;
+    case opRead:
+    {
+        ReadResult result = count > 1 ? file.readv(vectors, count) : file.read(request.buffer, request.size);
+        size_t remaining = result.value_or(0);
+        for (size_t i = 0; i < count; ++i) // A short read fills the first buffers.
+        {
+            chain[i]->isOk = result.has_value();
+            chain[i]->value = remaining < chain[i]->size ? remaining : chain[i]->size;
+            remaining -= chain[i]->value;
+        }
+        break;
+    }
+    case opWrite:
+    {
+        bool isOk = count > 1 ? file.writev(vectors, count) : file.write(request.buffer, request.size);
+        for (size_t i = 0; i < count; ++i)
+        {
+            chain[i]->isOk = isOk;
+            chain[i]->value = chain[i]->size;
+        }
+        break;
+    }
+    }
+    OS::TickCount elapsed = OS::getTick() - begin;
+    m_mutex.acquire();
+    if (elapsed > m_statistics.maxServiceTime) m_statistics.maxServiceTime = elapsed;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (chain[i]->isOk) ++m_statistics.completed; else ++m_statistics.failed;
+        chain[i]->next = nullptr;
+        chain[i]->state = done;
+    }
+    m_mutex.release();
+    for (size_t i = 0; i < count; ++i) OS::AppThread::sync(chain[i], deliver, chain[i]->context);
+}
+
+void FS::IOService::deliver(void *arg)
+{
+    Request& request = *static_cast<Request*>(arg);
+    if (request.operation == opRead)
+    {
+        auto result = static_cast<AsyncResultT<size_t>*>(request.result);
+        if (request.isOk) Async::setValue(&result, request.value);
+        else Async::fail(&result);
+    }
+    else
+    {
+        auto result = static_cast<AsyncResult*>(request.result);
+        if (request.isOk) Async::complete(&result);
+        else Async::fail(&result);
+    }
+    m_mutex.acquire();
+    request.state = available;
+    m_mutex.release();
+}
+
+void FS::IOService::workerEntry(OS::ThreadArg)
+{
+    for (;;)
+    {
+        m_wake.wait(wakeBit);
+        for (;;)
+        {
+            m_mutex.acquire();
+            Request* request = claim();
+            bool isMore = false;
+            for (const auto& other : m_requests) if (other.state == queued) isMore = true;
+            m_mutex.release();
+            if (!request) break;
+            if (isMore) m_wake.signal(wakeBit); // Let another worker take the next one.
+            execute(*request);
+        }
+    }
+}
+
+bool FS::IOService::assign(File &file, const char *absolutePath, FileMode mode, ...)
+{
+    va_list args;
+    va_start(args, mode);
+    bool result = file.assign(absolutePath, mode, args);
+    va_end(args);
+    return result;
+}
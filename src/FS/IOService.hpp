@@ -0,0 +1,191 @@
+/**
+ * @file        IOService.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Asynchronous file I/O service executing file operations on background threads. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Async.hpp"
+#include "File.hpp"
+#include "StaticClass.hpp"
+#include "OS/EventGroup.hpp"
+#include "OS/Mutex.hpp"
+#include "OS/Thread.hpp"
+
+#ifndef WTK_FS_IO_REQUESTS
+#define WTK_FS_IO_REQUESTS 8
+#endif
+
+#ifndef WTK_FS_IO_WORKERS
+#define WTK_FS_IO_WORKERS 1
+#endif
+
+#ifndef WTK_FS_IO_INFLIGHT
+#define WTK_FS_IO_INFLIGHT 1
+#endif
+
+namespace FS
+{
+
+/// @brief Executes file operations on background worker threads and delivers the completions to a thread context.
+/// @remarks The caller only queues the request, so the application thread is not blocked for the media access.
+///          The queue is bounded, the `...Async` methods return `nullptr` when it's full.
+///          The operations on the same file are executed in the order of submission,
+///          up to `WTK_FS_IO_INFLIGHT` operations are executed at once on the same media.
+///          Consecutive queued reads (or writes) of the same file are merged into one vectored `File::readv` (`writev`)
+///          call of up to `maxMerge` buffers, each request still gets its own completion.
+///          The merging happens in this queue only, the synchronous `File` calls are just ordered by the `IOScheduler`.
+///          The media transfers are ordered with the other threads by the `IOScheduler`, if enabled.
+///          Completions are scheduled with `OS::AppThread::sync` to the selected context,
+///          so set the `then` and `failed` callbacks before the target context processes its tasks,
+///          which is always the case when the target context is the calling one.
+///          The file and the buffer must stay valid until the completion is delivered.
+class IOService final
+{
+
+    STATIC(IOService)
+
+public:
+
+    static constexpr size_t maxRequests = WTK_FS_IO_REQUESTS;  // The maximal number of undelivered requests.
+    static constexpr size_t workers = WTK_FS_IO_WORKERS;        // The number of worker threads.
+    static constexpr size_t maxInFlight = WTK_FS_IO_INFLIGHT;   // The maximal number of operations executed at once per media.
+    static constexpr size_t maxMerge = 8;                       // The maximal number of requests merged into one transfer.
+
+    static_assert(maxRequests > 0, "WTK_FS_IO_REQUESTS must be at least 1");
+    static_assert(workers > 0 && maxInFlight > 0, "WTK_FS_IO_WORKERS and WTK_FS_IO_INFLIGHT must be at least 1");
+
+    /// @brief Service statistics.
+    struct Statistics
+    {
+        uint32_t submitted;             // The number of requests accepted.
+        uint32_t rejected;              // The number of requests rejected, because the queue was full or the arguments invalid.
+        uint32_t completed;             // The number of successful operations.
+        uint32_t failed;                // The number of failed operations.
+        uint32_t merged;                // The number of requests executed with a previous request of the same file.
+        OS::TickCount maxServiceTime;   // The longest operation execution time in system ticks.
+    };
+
+    /// @brief Opens a file asynchronously.
+    /// @param file A closed file reference.
+    /// @param absolutePath Absolute path to the file.
+    /// @param mode One or more flags from the `FileMode` enumeration.
+    /// @param context The thread context the completion is delivered to. Default: `application`.
+    /// @returns Asynchronous result pointer or `nullptr` if not queued.
+    static AsyncResult* openAsync(File& file, const char* absolutePath, FileMode mode, OS::ThreadContext context = OS::application);
+
+    /// @brief Closes a file asynchronously.
+    /// @param file File reference.
+    /// @param context The thread context the completion is delivered to. Default: `application`.
+    /// @returns Asynchronous result pointer or `nullptr` if not queued.
+    static AsyncResult* closeAsync(File& file, OS::ThreadContext context = OS::application);
+
+    /// @brief Reads the data from a file asynchronously.
+    /// @param file File reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes requested.
+    /// @param context The thread context the completion is delivered to. Default: `application`.
+    /// @returns Asynchronous result passing the number of bytes read, or `nullptr` if not queued.
+    static AsyncResultT<size_t>* readAsync(File& file, void* buffer, size_t size, OS::ThreadContext context = OS::application);
+
+    /// @brief Writes the data to a file asynchronously.
+    /// @param file File reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes to write.
+    /// @param context The thread context the completion is delivered to. Default: `application`.
+    /// @returns Asynchronous result pointer or `nullptr` if not queued.
+    static AsyncResult* writeAsync(File& file, const void* buffer, size_t size, OS::ThreadContext context = OS::application);
+
+    /// @returns The number of requests not delivered yet.
+    static size_t pending(void);
+
+    /// @returns Service statistics.
+    static inline const Statistics& statistics(void) { return m_statistics; }
+
+private:
+
+    /// @brief File operation type.
+    enum Operation : uint8_t
+    {
+        opOpen,     // Open the file.
+        opClose,    // Close the file.
+        opRead,     // Read from the file.
+        opWrite     // Write to the file.
+    };
+
+    /// @brief Request slot state.
+    enum State : uint8_t
+    {
+        available,  // The slot is not used.
+        queued,     // The request waits for a worker.
+        running,    // The request is executed by a worker.
+        done        // The request waits for the completion delivery.
+    };
+
+    /// @brief File operation request.
+    struct Request
+    {
+        State state;                // Request slot state.
+        Operation operation;        // File operation type.
+        OS::ThreadContext context;  // The thread context the completion is delivered to.
+        uint32_t sequence;          // Submission order.
+        File* file;                 // Target file.
+        const void* media;          // Target media, limits the number of operations in flight.
+        void* buffer;               // Data buffer.
+        size_t size;                // Data size.
+        void* result;               // Asynchronous result pointer.
+        size_t value;               // Passed value.
+        bool isOk;                  // True if the operation succeeded.
+        Request* next;              // The next merged request, `nullptr` if none.
+    };
+
+    /// @brief Sets the path of a closed file without opening it.
+    /// @param file File reference.
+    /// @param absolutePath Absolute path to the file.
+    /// @param mode One or more flags from the `FileMode` enumeration.
+    /// @param ... Variadic arguments used to format the path string.
+    /// @returns True if the path is valid and the file is not open.
+    static bool assign(File& file, const char* absolutePath, FileMode mode, ...);
+
+    /// @brief Queues a request.
+    /// @param operation File operation type.
+    /// @param file Target file.
+    /// @param buffer Data buffer.
+    /// @param size Data size.
+    /// @param result Asynchronous result pointer.
+    /// @param context The thread context the completion is delivered to.
+    /// @returns True if queued. False if the queue is full.
+    static bool submit(Operation operation, File& file, void* buffer, size_t size, void* result, OS::ThreadContext context);
+
+    /// @brief Takes the oldest request that can be executed now, with the following reads or writes of the file merged.
+    /// @remarks Call with the mutex held.
+    /// @returns Request pointer or `nullptr` if none can be executed.
+    static Request* claim(void);
+
+    /// @brief Executes a request with the merged requests in the worker thread.
+    /// @param request Request reference.
+    static void execute(Request& request);
+
+    /// @brief Delivers the completion in the target thread context and releases the request slot.
+    /// @param arg Request pointer.
+    static void deliver(void* arg);
+
+    /// @brief Worker thread entry point.
+    static void workerEntry(OS::ThreadArg);
+
+    static inline Request m_requests[maxRequests] = {};     // Request slots.
+    static inline OS::Thread m_threads[workers] = {};       // Worker threads.
+    static inline OS::Mutex m_mutex = {};                   // Serializes the request slots access.
+    static inline OS::EventGroup m_wake = {};               // Signalled when a request can be claimed.
+    static inline uint32_t m_sequence = 0;                  // The next request sequence number.
+    static inline bool m_isStarted = false;                 // True if the worker threads are started.
+    static inline Statistics m_statistics = {};             // Service statistics.
+
+};
+
+}
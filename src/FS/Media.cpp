@@ -11,13 +11,19 @@
 
 #include "OS/AppThread.hpp"
 #include "Media.hpp"
+#include "Adapter.hpp"
 #include "FileSystem.hpp"
 #include "Log.hpp"
+#include "StatCache.hpp"
+#include <cstring>
 
 #if defined(USE_FILEX)
 #include "fx_api.h"
 #elif defined(USE_FATFS)
 #include "fatfs.h"
+#include "BlockCache.hpp"
+#elif defined(USE_RAMFS)
+#include "AdapterRAM.hpp"
 #endif
 
 void FS::MediaServices::registerType(MediaType mediaType, const char* root, MediaDriver driver)
@@ -26,7 +32,11 @@ void FS::MediaServices::registerType(MediaType mediaType, const char* root, Medi
     if (!configuration) configuration = const_cast<MediaConfiguration*>(getConfiguration(MediaType::NONE));
     configuration->type = mediaType;
     configuration->root = root;
+#ifdef USE_FATFS
+    configuration->driver = BlockCache::wrap(driver);
+#else
     configuration->driver = driver;
+#endif
 }
 
 const FS::MediaConfiguration *FS::MediaServices::getConfiguration(MediaType mediaType)
@@ -37,7 +47,7 @@ const FS::MediaConfiguration *FS::MediaServices::getConfiguration(MediaType medi
 
 const FS::MediaConfiguration *FS::MediaServices::getConfiguration(const char *root)
 {
-    for (const auto& c : configurations) if (strcmp(root, c.root) == 0) return &c;
+    for (const auto& c : configurations) if (c.root && strcmp(root, c.root) == 0) return &c;
     return nullptr;
 }
 
@@ -66,24 +76,34 @@ bool FS::MediaServices::format(const char* root, MediaFormat format, const char
     return f_mkfs(root, opt, 0, buffer, bufferSize) == FR_OK;
 #elif defined(USE_FILEX)
 
+#elif defined(USE_RAMFS)
+    auto fs = FileSystemTable::find(root);
+    if (!fs || !fs->media()) return false;
+    AdapterRAM::format(*fs->media());
+    return true;
 #endif
     return false; // Not implemented yet.
 }
 
-bool FS::MediaServices::mount(Media &media, const char *root)
+bool FS::MediaServices::mount(Media &media, const char *root, const IAdapterMethods* adapter)
 {
+    if (!WTK_FS_ADAPTER_DISPATCH && adapter) return false; // The adapter would be silently ignored.
     auto entry = const_cast<FileSystem*>(FileSystemTable::find(root));
     if (!entry) // New entry.
     {
-        entry = const_cast<FileSystem*>(FileSystemTable::add(root, &media));
+        entry = const_cast<FileSystem*>(FileSystemTable::add(root, &media, adapter));
         if (!entry) return false; // FS table full.
     }
     else if (entry->m_media) // Existing entry with media set.
     {
-        if (entry->m_media == &media) return true; // Already mounted to this media.
+        if (entry->m_media == &media && entry->m_adapter == adapter) return true; // Already mounted to this media.
         return false;
     }
-    else entry->m_media = &media; // Existing entry without media set.
+    else // Existing entry without media set.
+    {
+        entry->m_media = &media;
+        entry->m_adapter = adapter;
+    }
     bool status = false;
 #ifdef USE_FATFS
     status = f_mount(&media, root, 0) == FR_OK;
@@ -98,6 +118,10 @@ bool FS::MediaServices::umount(const char *root)
 {
     auto entry = const_cast<FileSystem*>(FileSystemTable::find(root));
     if (!entry) return false; // FS root not found.
+    StatCache::flush(entry->media());
+#ifdef USE_FATFS
+    BlockCache::invalidate(); // The next media in the slot must not be served the sectors of this one.
+#endif
     entry->clear();
     notifyChanged();
     return true;
@@ -107,6 +131,10 @@ bool FS::MediaServices::umount(Media &media)
 {
     auto entry = const_cast<FileSystem*>(FileSystemTable::find(&media));
     if (!entry) return false; // Media not found.
+    StatCache::flush(&media);
+#ifdef USE_FATFS
+    BlockCache::invalidate(); // The next media in the slot must not be served the sectors of this one.
+#endif
     entry->clear();
     notifyChanged();
     return true;
@@ -18,9 +18,11 @@
 namespace FS
 {
 
+class IAdapterMethods;
+
 /// @brief Physical media type.
 enum class MediaType {
-    NONE, eMMC, SD, USB
+    NONE, eMMC, SD, USB, RAM
 };
 
 /// @brief Media file system format.
@@ -47,7 +49,7 @@ STATIC(MediaServices)
 
 public:
 
-    static constexpr size_t maxConfigurations = 3;  // Maximal number of media type configurations.
+    static constexpr size_t maxConfigurations = 4;  // Maximal number of media type configurations.
 
     /// @brief Registers a media type.
     /// @param mediaType Media type.
@@ -75,8 +77,12 @@ public:
     /// @brief Mounts a media to a specified file system root path.
     /// @param media Media structure reference to mount.
     /// @param root File system root path pointer.
-    /// @returns True if the media was successfully mounted, false otherwise.
-    static bool mount(Media& media, const char* root);
+    /// @param adapter The adapter layer serving this file system, `nullptr` for the compiled in adapter.
+    ///                It must work on the compiled in adapter handle types, like an `AdapterProxy` layer over `FS::adapter`.
+    ///                Mounting media of different backends side by side, e.g. FATFS next to FileX, is not implemented.
+    ///                Requires `WTK_FS_ADAPTER_DISPATCH` to be set.
+    /// @returns True if the media was successfully mounted, false otherwise, also when an adapter is passed with the dispatch disabled.
+    static bool mount(Media& media, const char* root, const IAdapterMethods* adapter = nullptr);
 
     /// @brief Unmouts a media from the specified system root path.
     /// @param root File system root path.
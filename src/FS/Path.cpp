@@ -13,54 +13,55 @@
 #include <cstring>
 #include <cstdio>
 
-FS::Path::Path() : m_fileSystem(), m_absolutePath(), m_relativePath() { }
+FS::Path::Path() : m_fileSystem(), m_rootLength(), m_path() { }
 
-FS::Path::Path(va_list args, const char* path) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(va_list args, const char* path) : m_fileSystem(), m_rootLength(), m_path()
 {
     initializeWithVariadicArgs(path, args);
 }
 
-FS::Path::Path(va_list args, const FileSystem *fs, const char *path) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(va_list args, const FileSystem *fs, const char *path) : m_fileSystem(), m_rootLength(), m_path()
 {
     initializeWithVariadicArgs(fs, path, args);
 }
 
-FS::Path::Path(const char *path, ...) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(const char *path, ...) : m_fileSystem(), m_rootLength(), m_path()
 {
     va_list args;
     va_start(args, path);
-    *this = Path(args, path);
+    initializeWithVariadicArgs(path, args);
     va_end(args);
 }
 
-FS::Path::Path(const FileSystem *fs, const char *path, ...) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(const FileSystem *fs, const char *path, ...) : m_fileSystem(), m_rootLength(), m_path()
 {
     va_list args;
     va_start(args, path);
-    *this = Path(args, fs, path);
+    initializeWithVariadicArgs(fs, path, args);
     va_end(args);
 }
 
 void FS::Path::initializeWithVariadicArgs(const char *path, va_list args)
 {
     m_fileSystem = FileSystemTable::find(path);
+    m_rootLength = 0;
+    m_path[0] = 0;
     if (!m_fileSystem || !m_fileSystem->root()) return;
-    va_list argsCopy;
-    va_copy(argsCopy, args);
-    std::vsnprintf(&m_absolutePath[0], maxLength, path, args);
-    std::vsnprintf(&m_relativePath[0], maxLength, path + std::strlen(m_fileSystem->root()), argsCopy);
-    va_end(argsCopy);
+    int length = std::vsnprintf(m_path, maxLength, path, args);
+    if (length < 0 || static_cast<size_t>(length) >= maxLength) m_path[0] = 0; // Don't address a truncated path.
+    else m_rootLength = std::strlen(m_fileSystem->root());
 }
 
 void FS::Path::initializeWithVariadicArgs(const FileSystem* fs, const char *path, va_list args)
 {
-    if (!fs || !fs->root()) return;
     m_fileSystem = fs;
-    auto rootLength = std::strlen(m_fileSystem->root());
-    std::memcpy(&m_absolutePath, m_fileSystem->root(), rootLength);
-    va_list argsCopy;
-    va_copy(argsCopy, args);
-    std::vsnprintf(&m_relativePath[0], maxLength, path, args);
-    std::vsnprintf(&m_absolutePath[0] + rootLength, maxLength - rootLength, path, argsCopy);
-    va_end(argsCopy);
+    m_rootLength = 0;
+    m_path[0] = 0;
+    if (!fs || !fs->root()) return;
+    size_t rootLength = std::strlen(fs->root());
+    if (rootLength >= maxLength) return;
+    std::memcpy(m_path, fs->root(), rootLength);
+    int length = std::vsnprintf(m_path + rootLength, maxLength - rootLength, path, args);
+    if (length < 0 || static_cast<size_t>(length) >= maxLength - rootLength) m_path[0] = 0; // Don't address a truncated path.
+    else m_rootLength = rootLength;
 }
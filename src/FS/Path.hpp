@@ -17,10 +17,12 @@ namespace FS
 {
 
 /// @brief A file system path in a file system context.
+/// @remarks The absolute path is stored once, formatted in a single pass. The relative path is a view at the root length offset.
+///          A path that doesn't fit `maxLength` is left empty, so it's not valid.
 struct Path : protected AdapterTypes
 {
 
-    static constexpr size_t maxLength = lfnMaxLength;   // Maximum allowed path length.
+    static constexpr size_t maxLength = lfnMaxLength;   // Maximum allowed absolute path length, including the terminator.
 
     /// @brief Creates an empty path target.
     Path();
@@ -51,15 +53,15 @@ struct Path : protected AdapterTypes
     inline const FileSystem* fileSystem() const { return m_fileSystem; }
 
     /// @returns The absolute path (containing the file system root path).
-    inline const char* absolutePath() const { return m_absolutePath; }
+    inline const char* absolutePath() const { return m_path; }
 
     /// @returns The relative path (relative to the file system root path).
-    inline const char* relativePath() const { return m_relativePath; }
+    inline const char* relativePath() const { return m_path + m_rootLength; }
 
     /// @returns True if the path target is fully configured.
     inline bool isValid() const
     {
-        return !!m_fileSystem && !!m_fileSystem->root() && !!m_fileSystem->media() && !!m_absolutePath[0] && !!m_relativePath[0];
+        return !!m_fileSystem && !!m_fileSystem->root() && !!m_fileSystem->media() && !!m_path[0] && !!m_path[m_rootLength];
     }
 
 protected:
@@ -77,9 +79,9 @@ protected:
 
 protected:
 
-    const FileSystem* m_fileSystem;       // File system target pointer
-    char m_absolutePath[lfnMaxLength];    // Absolute path string.
-    char m_relativePath[lfnMaxLength];    // Relative path string.
+    const FileSystem* m_fileSystem;     // File system target pointer
+    size_t m_rootLength;                // The length of the file system root path, the offset of the relative path.
+    char m_path[maxLength];             // Absolute path string.
 
 };
 
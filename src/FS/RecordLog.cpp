@@ -0,0 +1,199 @@
+/**
+ * @file        RecordLog.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Durable append-only record log with group commit. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "RecordLog.hpp"
+#include "Crc32.hpp"
+#include <algorithm>
+#include <cstring>
+
+/// @brief Calculates the record checksum of the length field and the data.
+/// @param header Record header pointer.
+/// @param data Record data pointer.
+/// @param length Record data length in bytes.
+/// @returns CRC32.
+static uint32_t recordCrc(const uint8_t* header, const void* data, size_t length)
+{
+    return Crc32::update(Crc32::update(0, header + 2, 2), data, length);
+}
+
+FS::RecordLog::RecordLog()
+    : m_file(), m_mutex(), m_commitMutex(), m_batches(), m_active(), m_half(),
+    m_commitSize(SIZE_MAX), m_interval(WTK_FS_RECORD_LOG_COMMIT_MS * WTK_OS_TICKS_PER_SECOND / 1000),
+    m_appended(), m_committed(), m_hasFailed(false), m_statistics() { }
+
+FS::RecordLog::~RecordLog() { close(); }
+
+bool FS::RecordLog::open(const FileSystem *fs, const char *path, void *buffer, size_t size, Fn3<const void*, size_t, void*, void> replay, void *context)
+{
+    if (isOpen() || !buffer || size / 2 <= headerSize) return false;
+    m_half = size / 2;
+    uint8_t* data = static_cast<uint8_t*>(buffer);
+    m_batches[0] = { data, 0, 0, 0 };
+    m_batches[1] = { data + m_half, 0, 0, 0 };
+    m_active = 0;
+    if (m_commitSize > m_half) m_commitSize = m_half;
+    m_appended = 0;
+    m_committed = 0;
+    m_hasFailed = false;
+    m_statistics = {};
+    if (!m_file.open(fs, "%s", FileMode::read | FileMode::write | FileMode::openAlways, path)) return false;
+    if (recover(replay, context)) return true;
+    m_file.close();
+    return false;
+}
+
+void FS::RecordLog::setCommitPolicy(size_t size, OS::TickCount interval)
+{
+    m_mutex.acquire();
+    m_commitSize = m_half && size > m_half ? m_half : size;
+    m_interval = interval;
+    m_mutex.release();
+}
+
+uint32_t FS::RecordLog::append(const void *data, size_t length)
+{
+    if (!isOpen() || (!data && length) || length > maxLength || headerSize + length > m_half) return 0;
+    for (;;)
+    {
+        m_mutex.acquire();
+        if (m_hasFailed)
+        {
+            m_mutex.release();
+            return 0;
+        }
+        Batch& batch = m_batches[m_active];
+        if (batch.length + headerSize + length > m_half) // The batch is full, commit it and retry.
+        {
+            m_mutex.release();
+            if (!commit()) return 0;
+            continue;
+        }
+        uint8_t* header = batch.data + batch.length;
+        header[0] = static_cast<uint8_t>(magic);
+        header[1] = static_cast<uint8_t>(magic >> 8);
+        header[2] = static_cast<uint8_t>(length);
+        header[3] = static_cast<uint8_t>(length >> 8);
+        uint32_t crc = recordCrc(header, data, length);
+        for (int i = 0; i < 4; ++i) header[4 + i] = static_cast<uint8_t>(crc >> (8 * i));
+        if (length) std::memcpy(header + headerSize, data, length);
+        OS::TickCount now = OS::getTick();
+        if (!batch.length) batch.start = now;
+        batch.length += headerSize + length;
+        uint32_t sequence = batch.last = ++m_appended;
+        ++m_statistics.records;
+        bool isDue = batch.length >= m_commitSize || (m_interval && now - batch.start >= m_interval);
+        m_mutex.release();
+        if (isDue && !commit(sequence)) return 0;
+        return sequence;
+    }
+}
+
+bool FS::RecordLog::commit(uint32_t sequence)
+{
+    if (!isOpen()) return false;
+    m_commitMutex.acquire();
+    m_mutex.acquire();
+    if (!sequence) sequence = m_appended;
+    m_mutex.release();
+    bool isDone = !m_hasFailed && (m_committed >= sequence || commitActive()); // Another commit could cover it already.
+    m_commitMutex.release();
+    return isDone;
+}
+
+bool FS::RecordLog::poll()
+{
+    if (!isOpen()) return false;
+    m_mutex.acquire();
+    const Batch& batch = m_batches[m_active];
+    bool isDue = batch.length && m_interval && OS::getTick() - batch.start >= m_interval;
+    bool hasFailed = m_hasFailed;
+    m_mutex.release();
+    return isDue ? commit() : !hasFailed;
+}
+
+bool FS::RecordLog::close()
+{
+    if (!isOpen()) return true;
+    bool isDone = commit();
+    m_file.close();
+    return isDone;
+}
+
+bool FS::RecordLog::recover(Fn3<const void*, size_t, void*, void> replay, void *context)
+{
+    uint8_t* data = m_batches[0].data; // The whole buffer, not used for appending yet.
+    const size_t capacity = 2 * m_half;
+    FileOffset offset = 0;
+    for (;;)
+    {
+        ReadResult result = m_file.read(data, headerSize);
+        if (!result.has_value()) return false;
+        if (result.value() < headerSize)
+        {
+            m_statistics.isTorn = result.value() > 0;
+            break;
+        }
+        uint16_t mark = static_cast<uint16_t>(data[0] | data[1] << 8);
+        size_t length = static_cast<size_t>(data[2] | data[3] << 8);
+        uint32_t crc = 0;
+        for (int i = 0; i < 4; ++i) crc |= static_cast<uint32_t>(data[4 + i]) << (8 * i);
+        if (mark != magic)
+        {
+            m_statistics.isTorn = true;
+            break;
+        }
+        bool isWhole = headerSize + length <= capacity; // Otherwise the data is checked in parts and can't be replayed.
+        uint32_t check = Crc32::update(0, data + 2, 2);
+        bool isShort = false;
+        for (size_t left = length; left && !isShort;)
+        {
+            size_t part = isWhole ? left : std::min(left, capacity - headerSize);
+            result = m_file.read(data + headerSize, part);
+            if (!result.has_value()) return false;
+            check = Crc32::update(check, data + headerSize, result.value());
+            isShort = result.value() < part;
+            left -= part;
+        }
+        if (isShort || check != crc)
+        {
+            m_statistics.isTorn = true;
+            break;
+        }
+        if (replay && !isWhole) return false; // A valid record doesn't fit the buffer, the file is left intact.
+        if (replay) replay(data + headerSize, length, context);
+        ++m_statistics.recovered;
+        offset += headerSize + length;
+    }
+    if (!m_file.seek(offset)) return false;
+    return !m_statistics.isTorn || (m_file.truncate() && m_file.sync()); // The next records start after the last valid one.
+}
+
+bool FS::RecordLog::commitActive()
+{
+    m_mutex.acquire();
+    Batch& batch = m_batches[m_active];
+    m_active ^= 1; // The appenders fill the other half while this one is written.
+    m_mutex.release();
+    if (!batch.length) return true;
+    bool isDone = m_file.write(batch.data, batch.length) && m_file.sync();
+    if (isDone)
+    {
+        m_committed = batch.last;
+        ++m_statistics.commits;
+    }
+    else
+    {
+        m_mutex.acquire();
+        m_hasFailed = true; // The batch records are lost, the file end is not known.
+        m_mutex.release();
+    }
+    batch.length = 0;
+    return isDone;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file        RecordLog.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Durable append-only record log with group commit. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Action.hpp"
+#include "File.hpp"
+#include "OS/Mutex.hpp"
+#include "OS/RTOS.hpp"
+#include <cstdint>
+
+#ifndef WTK_FS_RECORD_LOG_COMMIT_MS
+#define WTK_FS_RECORD_LOG_COMMIT_MS 100
+#endif
+
+namespace FS
+{
+
+/// @brief Appends CRC32 checked, length-prefixed records to a file, committing them to the media in batches.
+/// @remarks The records are collected in one half of the caller provided buffer while the other half is written.
+///          A batch is written and synced (`File::sync`) when it reaches the commit size, when the commit interval
+///          since its first record passes (checked by `append` and `poll`), or when `commit` is called.
+///          A record is durable when the `commit` for its sequence number returns true. Concurrent committers share
+///          a single sync: a record already covered by another thread's commit returns without writing.
+///          On `open` the existing records are validated (and optionally replayed) and a torn tail left by
+///          a power loss during a commit is truncated.
+///          All methods are thread safe.
+class RecordLog final : public AdapterTypes
+{
+
+public:
+
+    static constexpr uint16_t magic = 0x4c52;           // Record header mark ("RL").
+    static constexpr size_t headerSize = 8;             // Record header size in bytes.
+    static constexpr size_t maxLength = UINT16_MAX;     // The maximal record data length in bytes.
+
+    /// @brief Record log statistics.
+    struct Statistics
+    {
+        uint32_t records;   // The number of records appended since open.
+        uint32_t commits;   // The number of batches written and synced.
+        uint32_t recovered; // The number of valid records found on open.
+        bool isTorn;        // True if a torn tail was truncated on open.
+    };
+
+    /// @brief Creates a closed record log.
+    RecordLog();
+
+    /// @brief Commits the pending records and closes the log file.
+    ~RecordLog();
+
+    RecordLog(const RecordLog&) = delete;
+    RecordLog& operator=(const RecordLog&) = delete;
+
+    /// @brief Opens or creates the log file, validates the existing records and truncates a torn tail.
+    /// @param fs File system pointer.
+    /// @param path Log file path relative to the file system root.
+    /// @param buffer Batch buffer memory, split into 2 halves. An appended record with the header must fit in a half.
+    ///               With `replay` set, `open` fails without changing the file if an existing record doesn't fit the whole buffer.
+    /// @param size Batch buffer size in bytes.
+    /// @param replay Optional function called for each valid record found: data pointer, length, context.
+    /// @param context Replay function context.
+    /// @returns True if the log is open and ready to append. False otherwise.
+    bool open(const FileSystem* fs, const char* path, void* buffer, size_t size,
+        Fn3<const void*, size_t, void*, void> replay = nullptr, void* context = nullptr);
+
+    /// @returns True if the log is open.
+    inline bool isOpen() const { return m_file.isOpen(); }
+
+    /// @brief Sets the group commit thresholds.
+    /// @param size The pending batch size in bytes that triggers a commit, clamped to the buffer half.
+    /// @param interval The maximal time in ticks a record stays pending, 0 commits only on size or `commit`.
+    void setCommitPolicy(size_t size, OS::TickCount interval);
+
+    /// @brief Appends a record to the current batch. Commits the batch first if the record doesn't fit.
+    /// @param data Record data pointer.
+    /// @param length Record data length in bytes.
+    /// @returns The record sequence number (starting at 1) to pass to `commit`, 0 if failed.
+    uint32_t append(const void* data, size_t length);
+
+    /// @brief Writes and syncs the pending records up to the sequence number.
+    /// @param sequence The sequence number returned by `append`, 0 to commit all pending records.
+    /// @returns True if the record is on the media. False if the write or the sync failed.
+    bool commit(uint32_t sequence = 0);
+
+    /// @brief Commits the pending records if the oldest one is pending longer than the commit interval.
+    /// @remarks Call it periodically if the records can be appended in bursts.
+    /// @returns True if there's nothing to commit or the commit succeeded. False if the commit failed.
+    bool poll();
+
+    /// @brief Commits the pending records and closes the log file.
+    /// @returns True if all records were committed. False otherwise.
+    bool close();
+
+    /// @returns Log statistics.
+    inline Statistics statistics() const { return m_statistics; }
+
+private:
+
+    /// @brief Batch buffer half.
+    struct Batch
+    {
+        uint8_t* data;          // Batch data pointer.
+        size_t length;          // The number of pending bytes.
+        uint32_t last;          // The sequence number of the last record in the batch.
+        OS::TickCount start;    // The time the first record was appended.
+    };
+
+    /// @brief Validates the records from the start of the file and truncates the file after the last valid one.
+    /// @param replay Optional record function.
+    /// @param context Record function context.
+    /// @returns True if done. False if the file could not be read or truncated, or a record to replay doesn't fit the buffer.
+    bool recover(Fn3<const void*, size_t, void*, void> replay, void* context);
+
+    /// @brief Writes and syncs the active batch, swapping the batch halves. The commit mutex must be held.
+    /// @returns True if done. False if the write or the sync failed, the records are lost.
+    bool commitActive();
+
+    File m_file;                        // Log file.
+    OS::Mutex m_mutex;                  // Protects the active batch.
+    OS::Mutex m_commitMutex;            // Serializes the commits.
+    Batch m_batches[2];                 // Batch buffer halves.
+    size_t m_active;                    // The index of the batch receiving the records.
+    size_t m_half;                      // Batch buffer half size in bytes.
+    size_t m_commitSize;                // The pending size that triggers a commit.
+    OS::TickCount m_interval;           // The maximal pending time in ticks.
+    uint32_t m_appended;                // The sequence number of the last appended record.
+    uint32_t m_committed;               // The sequence number of the last durable record.
+    bool m_hasFailed;                   // A commit failed, the log is not appendable.
+    Statistics m_statistics;            // Log statistics.
+
+};
+
+}
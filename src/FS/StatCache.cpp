@@ -0,0 +1,116 @@
+/**
+ * @file        StatCache.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Bounded LRU cache of the file and directory metadata query results. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "StatCache.hpp"
+#include <cctype>
+
+bool FS::StatCache::lookup(const Path &path, Query query, Status &status, uint32_t &generation, DateTime *dateTime)
+{
+    if (!isEnabled()) return false;
+    uint64_t key = hash(path);
+    m_mutex.acquire();
+    Entry* entry = find(path.fileSystem()->media(), key);
+    bool isHit = entry && (entry->known & (1u << query));
+    if (isHit)
+    {
+        entry->used = ++m_clock;
+        status = entry->status[query];
+        if (dateTime && query == modified) *dateTime = entry->modified;
+        ++m_statistics.hits;
+    }
+    else
+    {
+        generation = m_generation;
+        ++m_statistics.misses;
+    }
+    m_mutex.release();
+    return isHit;
+}
+
+void FS::StatCache::store(const Path &path, Query query, uint32_t generation, Status status, const DateTime *dateTime)
+{
+    if (!isEnabled()) return;
+    const Media* media = path.fileSystem()->media();
+    uint64_t key = hash(path);
+    m_mutex.acquire();
+    if (generation != m_generation) // Changed while queried, the result could be stale.
+    {
+        m_mutex.release();
+        return;
+    }
+    Entry* entry = find(media, key);
+    if (!entry) // Take a free entry or the least recently used one.
+    {
+        entry = &m_entries[0];
+        for (auto& e : m_entries)
+        {
+            if (!e.media) { entry = &e; break; }
+            if (e.used < entry->used) entry = &e;
+        }
+        if (entry->media) ++m_statistics.evictions;
+        *entry = {};
+        entry->media = media;
+        entry->hash = key;
+    }
+    entry->used = ++m_clock;
+    entry->known |= 1u << query;
+    entry->status[query] = status;
+    if (dateTime && query == modified) entry->modified = *dateTime;
+    m_mutex.release();
+}
+
+void FS::StatCache::invalidate(const Path &path)
+{
+    if (!isEnabled()) return;
+    uint64_t key = hash(path);
+    m_mutex.acquire();
+    Entry* entry = find(path.fileSystem()->media(), key);
+    if (entry)
+    {
+        *entry = {};
+        ++m_statistics.invalidations;
+    }
+    ++m_generation;
+    m_mutex.release();
+}
+
+void FS::StatCache::flush(const Media *media)
+{
+    if (!isEnabled()) return;
+    m_mutex.acquire();
+    for (auto& e : m_entries)
+    {
+        if (!e.media || (media && e.media != media)) continue;
+        e = {};
+        ++m_statistics.invalidations;
+    }
+    ++m_generation;
+    m_mutex.release();
+}
+
+uint64_t FS::StatCache::hash(const Path &path)
+{
+    uint64_t value = 0xcbf29ce484222325ULL;
+    const char* p = path.relativePath();
+    while (*p == '/') ++p; // The same entry can be addressed with or without the leading slash.
+    for (; *p; ++p)
+    {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (!caseSensitive) c = static_cast<uint8_t>(std::tolower(c));
+        value = (value ^ c) * 0x100000001b3ULL;
+    }
+    return value;
+}
+
+FS::StatCache::Entry* FS::StatCache::find(const Media *media, uint64_t hash)
+{
+    for (auto& e : m_entries) if (e.media && e.media == media && e.hash == hash) return &e;
+    return nullptr;
+}
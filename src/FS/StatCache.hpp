@@ -0,0 +1,126 @@
+/**
+ * @file        StatCache.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Bounded LRU cache of the file and directory metadata query results. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Path.hpp"
+#include "StaticClass.hpp"
+#include "OS/Mutex.hpp"
+#include <cstdint>
+
+#ifndef WTK_FS_STAT_CACHE
+#define WTK_FS_STAT_CACHE 0
+#endif
+
+namespace FS
+{
+
+/// @brief Bounded LRU cache of the `fileExists`, `directoryExists` and `modified` query results.
+/// @remarks The entries are keyed by the media and the 64-bit FNV-1a hash of the relative path.
+///          Both positive and negative results are cached. The entries are invalidated by the `FS` API create, rename
+///          and delete functions and by the files opened for writing. The media entries are flushed when it's unmounted.
+///          Changes made to the media bypassing the `FS` API (like a USB mass storage host) require a manual `flush`.
+///          The changes invalidate the entries after the adapter call, and a query result is not stored if any entry
+///          was invalidated since the query missed the cache, so a query racing a change can't cache the old state.
+///          Disabled when `WTK_FS_STAT_CACHE` is 0 (default).
+class StatCache final : public AdapterTypes
+{
+
+    STATIC(StatCache)
+
+public:
+
+    static constexpr size_t capacity = WTK_FS_STAT_CACHE; // The number of cached paths.
+
+    /// @brief Cached query type.
+    enum Query : uint8_t
+    {
+        fileExists,         // The `fileExists` adapter status.
+        directoryExists,    // The `directoryExists` adapter status.
+        modified,           // The `modified` adapter status and time.
+        queries             // The number of query types.
+    };
+
+    /// @brief Cache statistics.
+    struct Statistics
+    {
+        uint32_t hits;          // The number of queries answered from the cache.
+        uint32_t misses;        // The number of queries passed to the adapter.
+        uint32_t evictions;     // The number of the least recently used entries replaced.
+        uint32_t invalidations; // The number of entries invalidated by the changes.
+    };
+
+    /// @returns True if the cache is compiled in.
+    static constexpr bool isEnabled(void) { return capacity > 0; }
+
+    /// @brief Gets a cached query result.
+    /// @param path Resolved path.
+    /// @param query Query type.
+    /// @param status Cached adapter status reference.
+    /// @param generation Invalidation counter reference, set on a miss to be passed to `store`.
+    /// @param dateTime Cached modification time pointer, set for the `modified` query if not `nullptr`.
+    /// @returns True if the result was cached. False otherwise.
+    static bool lookup(const Path& path, Query query, Status& status, uint32_t& generation, DateTime* dateTime = nullptr);
+
+    /// @brief Stores a query result, replacing the least recently used entry if the cache is full.
+    /// @remarks The result is dropped if any entry was invalidated since the `lookup` miss.
+    /// @param path Resolved path.
+    /// @param query Query type.
+    /// @param generation Invalidation counter set by the `lookup` miss.
+    /// @param status Adapter status.
+    /// @param dateTime Modification time pointer, for the `modified` query.
+    static void store(const Path& path, Query query, uint32_t generation, Status status, const DateTime* dateTime = nullptr);
+
+    /// @brief Removes the entry of the path, if cached.
+    /// @param path Resolved path.
+    static void invalidate(const Path& path);
+
+    /// @brief Removes the media entries.
+    /// @param media Media pointer, `nullptr` to remove all entries.
+    static void flush(const Media* media = nullptr);
+
+    /// @returns Cache statistics.
+    static inline const Statistics& statistics(void) { return m_statistics; }
+
+    /// @brief Zeroes the cache statistics.
+    static inline void resetStatistics(void) { m_statistics = {}; }
+
+private:
+
+    /// @brief Cached path entry.
+    struct Entry
+    {
+        const Media* media;         // Media pointer, `nullptr` if the entry is not used.
+        uint64_t hash;              // Relative path hash.
+        uint32_t used;              // The access clock value of the last use.
+        uint8_t known;              // Cached query bits, `1 << Query`.
+        Status status[queries];     // Cached adapter statuses.
+        DateTime modified;          // Cached modification time.
+    };
+
+    /// @returns The 64-bit FNV-1a hash of the relative path, case insensitive on FAT file systems.
+    /// @param path Resolved path.
+    static uint64_t hash(const Path& path);
+
+    /// @returns The entry matching the key or `nullptr` if not cached.
+    /// @param media Media pointer.
+    /// @param hash Relative path hash.
+    static Entry* find(const Media* media, uint64_t hash);
+
+    static constexpr size_t slots = capacity ? capacity : 1;    // The entry array size.
+    static inline Entry m_entries[slots] = {};                  // Cached entries.
+    static inline OS::Mutex m_mutex = {};                       // Serializes the entries access.
+    static inline uint32_t m_clock = 0;                         // The access clock, incremented on each use.
+    static inline uint32_t m_generation = 0;                    // Incremented on each invalidation.
+    static inline Statistics m_statistics = {};                 // Cache statistics.
+
+};
+
+}
@@ -0,0 +1,141 @@
+/**
+ * @file        StreamReader.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Double buffered sequential file reader with background read-ahead. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "StreamReader.hpp"
+
+static constexpr OS::EventFlags signalBit = 1; // The only event flag used.
+
+FS::StreamReader::StreamReader(File &file, void *buffer, size_t size)
+    : m_file(file), m_data(), m_size(buffer ? size >> 1 : 0), m_length(), m_start(), m_failed(), m_isFull(), m_isPending(),
+    m_current(1), m_consumed(), m_position(), m_fetchOffset(), m_isEnd(),
+    m_sequential(sequentialThreshold), m_filled(), m_statistics()
+{
+    m_data[0] = static_cast<uint8_t*>(buffer);
+    m_data[1] = m_data[0] + m_size;
+    if (!m_size || !m_file.tell(m_position)) return;
+    m_fetchOffset = m_position;
+    prefetch(0); // Opening a stream implies sequential access.
+}
+
+FS::StreamReader::~StreamReader() { waitIdle(); }
+
+FS::StreamResult FS::StreamReader::next(size_t maxLength)
+{
+    if (!m_size || !m_file.isOpen()) return StreamResult();
+    if (m_consumed >= m_length[m_current])
+    {
+        if (m_isEnd && !m_isPending && !m_isFull[m_current ^ 1]) return StreamView { m_data[m_current], 0 };
+        if (!advance()) return StreamResult();
+    }
+    size_t length = m_length[m_current] - m_consumed;
+    if (length > maxLength) length = maxLength;
+    StreamView view { m_data[m_current] + m_consumed, length };
+    m_consumed += length;
+    m_position += length;
+    m_statistics.bytes += length;
+    return view;
+}
+
+bool FS::StreamReader::seek(FileOffset offset)
+{
+    if (!m_size || !m_file.isOpen()) return false;
+    if (offset == m_position) return true;
+    if (m_isFull[m_current] && offset >= m_start[m_current] && offset - m_start[m_current] < m_length[m_current])
+    { // Within the current buffer.
+        m_consumed = static_cast<size_t>(offset - m_start[m_current]);
+        m_position = offset;
+        return true;
+    }
+    waitIdle();
+    m_isFull[0] = m_isFull[1] = false;
+    m_length[m_current] = 0;
+    m_consumed = 0;
+    m_isEnd = false;
+    m_sequential = 0;
+    if (!m_file.seek(offset)) return false;
+    m_position = m_fetchOffset = offset;
+    return true;
+}
+
+bool FS::StreamReader::advance(void)
+{
+    size_t other = m_current ^ 1;
+    if (m_isPending || !m_isFull[other]) // Don't touch the buffer the I/O thread fills.
+    {
+        if (!m_isPending || !m_filled.wait(signalBit, OS::waitAny, 0))
+        {
+            OS::TickCount begin = OS::getTick();
+            ++m_statistics.stalls;
+            if (m_isPending) m_filled.wait(signalBit);
+            else fill(other); // Not sequential yet or the request queue was full.
+            m_statistics.stallTime += OS::getTick() - begin;
+        }
+        if (m_isPending) ++m_statistics.prefetched;
+        m_isPending = false;
+        ++m_statistics.fills;
+    }
+    m_isFull[m_current] = false;
+    m_current = other;
+    m_consumed = 0;
+    if (m_failed[other]) return false;
+    if (m_sequential < sequentialThreshold) ++m_sequential;
+    if (m_sequential >= sequentialThreshold && !m_isEnd) prefetch(other ^ 1);
+    return true;
+}
+
+void FS::StreamReader::fill(size_t index)
+{
+    ReadResult result = m_file.read(m_data[index], m_size);
+    m_start[index] = m_fetchOffset;
+    m_length[index] = result.value_or(0);
+    m_failed[index] = !result.has_value();
+    m_isFull[index] = true;
+    m_fetchOffset += m_length[index];
+    m_isEnd = m_length[index] < m_size;
+}
+
+void FS::StreamReader::prefetch(size_t index)
+{
+    m_mutex.acquire();
+    if (!m_isStarted)
+    {
+        m_thread.start(ioEntry, "StreamReader", OS::ThreadPriority::aboveNormal);
+        m_isStarted = true;
+    }
+    m_isPending = m_head - m_tail < maxRequests;
+    if (m_isPending) m_queue[m_head++ % maxRequests] = { this, index };
+    m_mutex.release();
+    if (m_isPending) m_requested.signal(signalBit);
+}
+
+void FS::StreamReader::waitIdle(void)
+{
+    if (!m_isPending) return;
+    m_filled.wait(signalBit);
+    m_isPending = false;
+}
+
+void FS::StreamReader::ioEntry(OS::ThreadArg)
+{
+    for (;;)
+    {
+        m_requested.wait(signalBit);
+        for (;;)
+        {
+            m_mutex.acquire();
+            bool isTaken = m_tail != m_head;
+            Request request = isTaken ? m_queue[m_tail++ % maxRequests] : Request();
+            m_mutex.release();
+            if (!isTaken) break;
+            request.reader->fill(request.index);
+            request.reader->m_filled.signal(signalBit);
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/**
+ * @file        StreamReader.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Double buffered sequential file reader with background read-ahead. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "File.hpp"
+#include "OS/Mutex.hpp"
+#include "OS/EventGroup.hpp"
+#include "OS/Thread.hpp"
+#include <cstdint>
+#include <optional>
+
+#ifndef WTK_FS_STREAMS
+#define WTK_FS_STREAMS 4
+#endif
+
+namespace FS
+{
+
+/// @brief A read only view of the data in a stream buffer.
+struct StreamView
+{
+    const uint8_t* data;    // The first byte of the data.
+    size_t length;          // The number of bytes available, 0 at the end of the file.
+};
+
+/// @brief Stream read result: a view, or an empty value if an error occurred.
+using StreamResult = std::optional<StreamView>;
+
+/// @brief Reads a file sequentially through 2 buffers, while one is consumed, the other is filled by the background I/O thread.
+/// @remarks Returns views into the filled buffer instead of copying the data.
+///          Read-ahead starts when the access is sequential: right after the construction,
+///          or after `sequentialThreshold` consecutive buffers were consumed following a `seek` outside the buffered data.
+///          All readers share one lazily started I/O thread, up to `WTK_FS_STREAMS` read-ahead requests can be queued.
+///          The file must not be accessed directly while the reader exists.
+class StreamReader final : public AdapterTypes
+{
+
+public:
+
+    static constexpr size_t maxRequests = WTK_FS_STREAMS;  // The maximal number of queued read-ahead requests.
+    static constexpr uint32_t sequentialThreshold = 2;      // The number of consecutive buffers that make the access sequential.
+
+    /// @brief Reader statistics.
+    struct Statistics
+    {
+        uint64_t bytes;             // The number of bytes returned in views.
+        uint32_t fills;             // The number of buffers filled.
+        uint32_t prefetched;        // The number of buffers filled by the I/O thread.
+        uint32_t stalls;            // The number of times the reader waited for the data.
+        OS::TickCount stallTime;    // The total time the reader waited for the data in system ticks.
+    };
+
+    /// @brief Creates a reader for an open file, starting at the current file offset.
+    /// @param file File reference.
+    /// @param buffer Buffer pointer, split in 2 halves.
+    /// @param size Buffer size in bytes. One read from the file reads a half of it.
+    StreamReader(File& file, void* buffer, size_t size);
+
+    /// @brief Waits for the pending read-ahead to complete.
+    ~StreamReader();
+
+    StreamReader(const StreamReader&) = delete; // This type should not be copied.
+    StreamReader(StreamReader&&) = delete; // This type should not be moved.
+
+    /// @brief Gets the next part of the file. DO NOT CALL FROM ISR!
+    /// @param maxLength The maximal number of bytes to return. Default: the rest of the buffer.
+    /// @returns A view valid until the next `next` or `seek` call, with zero length at the end of the file. Empty value on error.
+    StreamResult next(size_t maxLength = SIZE_MAX);
+
+    /// @brief Moves the read position. Seeking within the buffered data doesn't read the file.
+    /// @param offset File offset.
+    /// @returns True if done. False otherwise.
+    bool seek(FileOffset offset);
+
+    /// @returns The file offset of the next byte returned.
+    inline FileOffset position() const { return m_position; }
+
+    /// @returns Reader statistics.
+    inline const Statistics& statistics() const { return m_statistics; }
+
+private:
+
+    /// @brief Read-ahead request.
+    struct Request
+    {
+        StreamReader* reader;   // Requesting reader.
+        size_t index;           // The index of the buffer to fill.
+    };
+
+    /// @brief Switches to the other buffer, filling it if not filled by the I/O thread.
+    /// @returns True if done. False if the file read failed.
+    bool advance(void);
+
+    /// @brief Reads the next part of the file into a buffer.
+    /// @param index Buffer index.
+    void fill(size_t index);
+
+    /// @brief Queues the buffer to be filled by the I/O thread.
+    /// @param index Buffer index.
+    void prefetch(size_t index);
+
+    /// @brief Waits until the buffer queued by `prefetch` is filled.
+    void waitIdle(void);
+
+    /// @brief Processes the read-ahead requests.
+    static void ioEntry(OS::ThreadArg);
+
+    File& m_file;                       // Source file.
+    uint8_t* m_data[2];                 // Buffer halves.
+    size_t m_size;                      // The size of one buffer half.
+    size_t m_length[2];                 // The number of bytes read into each buffer.
+    FileOffset m_start[2];              // The file offset of the first byte of each buffer.
+    bool m_failed[2];                   // True if the buffer fill failed.
+    bool m_isFull[2];                   // True if the buffer was filled.
+    bool m_isPending;                   // True if a buffer is queued to be filled by the I/O thread.
+    size_t m_current;                   // The index of the buffer being consumed.
+    size_t m_consumed;                  // The number of bytes consumed from the current buffer.
+    FileOffset m_position;              // The file offset of the next byte returned.
+    FileOffset m_fetchOffset;           // The file offset of the next buffer fill.
+    bool m_isEnd;                       // True if the last fill reached the end of the file.
+    uint32_t m_sequential;              // The number of buffers consumed since the last seek.
+    OS::EventGroup m_filled;            // Signalled when the I/O thread fills a buffer.
+    Statistics m_statistics;            // Reader statistics.
+
+    static inline OS::Thread m_thread = {};                     // Shared I/O thread.
+    static inline OS::Mutex m_mutex = {};                       // Serializes the request queue access.
+    static inline OS::EventGroup m_requested = {};              // Signalled when a request is queued.
+    static inline Request m_queue[maxRequests] = {};            // Read-ahead request ring.
+    static inline size_t m_head = 0;                            // The number of requests ever queued.
+    static inline size_t m_tail = 0;                            // The number of requests ever taken.
+    static inline bool m_isStarted = false;                     // True if the I/O thread is started.
+
+};
+
+}
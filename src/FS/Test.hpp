@@ -29,6 +29,7 @@ public:
 
     static constexpr size_t bufferSize = 16384; // Test buffer size.
     static constexpr size_t slack = 10; // Make the actual file size this amount of byte smaller than the buffer size.
+    static constexpr size_t testFiles = 6; // The number of files created by the directory API test.
 
     /// @brief Tests the file API.
     /// @param fs File system pointer.
@@ -120,6 +121,61 @@ public:
         return true;
     }
 
+    /// @brief Tests the directory enumeration API.
+    /// @param fs File system pointer.
+    /// @param directoryName Test directory name, the directory should not exist.
+    /// @returns True if passed, false if failed.
+    static bool directoryAPI(const FileSystem* fs, const char* directoryName)
+    {
+        if (!fs || !directoryName)
+        {
+            Log::msg(LogMessage::error, "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS directory API, directory = %s%s:", fs->root(), directoryName);
+        if (!directoryCreate(fs, directoryName))
+        {
+            Log::msg(LogMessage::error, "Create directory failed!");
+            return false;
+        }
+        Log::msg("Creating files...");
+        for (size_t i = 0; i < testFiles; ++i)
+        {
+            if (!fileCreate(fs, "%s/%u.%s", directoryName, i, i % 2 ? "bin" : "txt"))
+            {
+                Log::msg(LogMessage::error, "Create file failed!");
+                return false;
+            }
+        }
+        bool passed = true;
+        { // The directory should be closed before its entries are deleted.
+            Log::msg("Listing...");
+            Directory directory(fs, directoryName);
+            size_t all = 0;
+            for (const auto& entry : directory) if ((entry.attributes & EntryAttributes::directory) == EntryAttributes::none) ++all;
+            Log::msg("Listing matching...");
+            directory.rewind();
+            directory.setPattern("*.bin");
+            EntryInfo batch[2];
+            size_t matching = 0;
+            for (size_t count; (count = directory.read(batch, 2)); ) matching += count;
+            if (!directory || directory.hasFailed() || all != testFiles || matching != testFiles / 2)
+            {
+                Log::msg(LogMessage::error, "Invalid listing: %u entries, %u matching!", all, matching);
+                passed = false;
+            }
+        }
+        Log::msg("Deleting...");
+        for (size_t i = 0; i < testFiles; ++i) fileDelete(fs, "%s/%u.%s", directoryName, i, i % 2 ? "bin" : "txt");
+        if (!directoryDelete(fs, directoryName))
+        {
+            Log::msg(LogMessage::error, "Delete directory failed!");
+            return false;
+        }
+        if (passed) Log::msg("SUCCESS!");
+        return passed;
+    }
+
 private:
 
     /// @brief Fills the buffer with zeroes.
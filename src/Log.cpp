@@ -55,7 +55,8 @@ void Log::dump(const char *format, ...)
     if (m_output && !m_output->isAvailable()) return;
     if (m_level < LogMessage::detail) return;
     auto [message, offset] = getMessage(LogMessage::detail); if (!message) return;
-    if (m_dumpIndentation) message->add(' ', m_dumpIndentation);
+    size_t indentation = m_dumpIndentation.get();
+    if (indentation) message->add(' ', indentation);
     va_list args;
     va_start(args, format);
     message->vprintf(format, args)->add("\r\n");
@@ -13,6 +13,7 @@
 #include "ILogOutput.hpp"
 #include "LogMessagePool.hpp"
 #include "StaticClass.hpp"
+#include "OS/ThreadLocal.hpp"
 #include <cstdarg>
 
 /// @brief Provides methods of sending messages to a static system log.
@@ -69,10 +70,10 @@ public:
     /// @param ... Variadic arguments.
     static void msg(LogMessage::Severity severity, const char* format, ...);
 
-    /// @returns Current dump indentation value.
-    static inline size_t dumpIndentation() { return m_dumpIndentation; }
+    /// @returns Current dump indentation value of the calling thread.
+    static inline size_t dumpIndentation() { return m_dumpIndentation.get(); }
 
-    /// @brief Sets the current dump indentation.
+    /// @brief Sets the current dump indentation of the calling thread.
     /// @param value The number of text columns to indent the dump lines.
     static inline void dumpIndentation(size_t value) { m_dumpIndentation = value; }
 
@@ -92,6 +93,6 @@ protected:
     static inline LogMessage::Severity m_level = LogMessage::detail;    // Default log level. Messages above this level will be discarded.
     static inline LogMessagePool<WTK_LOG_Q> m_pool = {};                // Static message pool.
     static inline ILogOutput* m_output = {};                            // Message output implementation.
-    static inline size_t m_dumpIndentation = dumpIndentationDefault;    // Current dump line indentation.
+    static inline OS::ThreadLocal<size_t> m_dumpIndentation { dumpIndentationDefault }; // Current dump line indentation per thread.
 
 };
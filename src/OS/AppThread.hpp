@@ -92,6 +92,10 @@ public:
     /// @param id Task identifier reference. Gets zeroed if task canceled.
     static inline void cancel(TaskId& taskId) { m_scheduler.cancel(taskId); }
 
+    /// @returns A description of the action being executed in the selected thread context. ISR safe.
+    /// @param context Thread context.
+    static inline RunningAction running(ThreadContext context = application) { return Task::running(context); }
+
 private:
 
     static inline TaskScheduler m_scheduler{};
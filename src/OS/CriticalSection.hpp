@@ -0,0 +1,60 @@
+/**
+ * @file        CriticalSection.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A scope in which the current thread or ISR cannot be preempted. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "CurrentThread.hpp"
+
+namespace OS
+{
+
+/// @brief Enters a critical section on creation and leaves it on going out of scope. ISR safe.
+/// @remarks Keep the scope as short as possible, interrupts are masked. Do not call blocking functions inside.
+class CriticalSection final
+{
+
+public:
+
+    /// @brief Enters the critical section.
+    CriticalSection() : m_isISR(CurrentThread::isISRContext()), m_saved()
+    {
+#if defined(USE_AZURE_RTOS)
+        m_saved = __get_PRIMASK();
+        __disable_irq();
+#elif defined(USE_FREE_RTOS)
+        if (m_isISR) m_saved = taskENTER_CRITICAL_FROM_ISR();
+        else taskENTER_CRITICAL();
+#endif
+    }
+
+    /// @brief Leaves the critical section.
+    ~CriticalSection()
+    {
+#if defined(USE_AZURE_RTOS)
+        __set_PRIMASK(m_saved);
+#elif defined(USE_FREE_RTOS)
+        if (m_isISR) taskEXIT_CRITICAL_FROM_ISR(m_saved);
+        else taskEXIT_CRITICAL();
+#endif
+    }
+
+    /// @brief This type cannot be copied.
+    CriticalSection(const CriticalSection&) = delete;
+
+    /// @brief This type cannot be moved.
+    CriticalSection(CriticalSection&&) = delete;
+
+private:
+    bool m_isISR;       // True if entered from ISR.
+    uint32_t m_saved;   // Saved interrupt mask.
+
+};
+
+}
@@ -0,0 +1,62 @@
+/**
+ * @file        Doorbell.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Inter-core notification using the hardware semaphore release interrupts. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Doorbell.hpp"
+
+#if defined(HSEM)
+
+#include "CurrentThread.hpp"
+#include "Crash.hpp"
+
+OS::Doorbell::~Doorbell()
+{
+    if (m_rx < semaphores && m_registry[m_rx] == this)
+    {
+        HAL_HSEM_DeactivateNotification(__HAL_HSEM_SEMID_TO_MASK(m_rx));
+        m_registry[m_rx] = nullptr;
+    }
+}
+
+bool OS::Doorbell::enable(void)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    if (m_rx >= semaphores || m_tx >= semaphores) return false;
+    if (m_registry[m_rx] && m_registry[m_rx] != this) return false;
+    m_event.clear(ringBit); // Also creates the event group before the first interrupt.
+    m_registry[m_rx] = this;
+    HAL_HSEM_ActivateNotification(__HAL_HSEM_SEMID_TO_MASK(m_rx));
+    return true;
+}
+
+bool OS::Doorbell::ring(void)
+{
+    if (HAL_HSEM_FastTake(m_tx) != HAL_OK) return false;
+    HAL_HSEM_Release(m_tx, 0);
+    return true;
+}
+
+bool OS::Doorbell::wait(TickCount timeout)
+{
+    return (m_event.wait(ringBit, waitAny, timeout) & ringBit) != 0;
+}
+
+void OS::Doorbell::isr(uint32_t semaphoreMask)
+{
+    uint32_t active = 0;
+    for (uint32_t i = 0; i < semaphores; ++i)
+    {
+        if (!(semaphoreMask & __HAL_HSEM_SEMID_TO_MASK(i)) || !m_registry[i]) continue;
+        m_registry[i]->m_event.signal(ringBit);
+        active |= __HAL_HSEM_SEMID_TO_MASK(i);
+    }
+    if (active) HAL_HSEM_ActivateNotification(active); // The HAL disables the notification before calling back.
+}
+
+#endif
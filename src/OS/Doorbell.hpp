@@ -0,0 +1,78 @@
+/**
+ * @file        Doorbell.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Inter-core notification using the hardware semaphore release interrupts. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "hal.h"
+#include "EventGroup.hpp"
+#include <cstdint>
+
+#if defined(HSEM)
+
+namespace OS
+{
+
+/// @brief Inter-core notification using the hardware semaphore (HSEM) release interrupts.
+/// @remarks Each core uses its own instance, with the receive and the transmit semaphores swapped.
+///          The HSEM interrupt must be enabled for the receiving core and `HAL_HSEM_FreeCallback` must call `Doorbell::isr`.
+class Doorbell final
+{
+
+public:
+
+    static constexpr uint32_t semaphores = 32; // The number of available hardware semaphores.
+
+    /// @brief Creates a doorbell. Call `enable` before waiting.
+    /// @param rxSemaphore The semaphore released by the other core to notify this core.
+    /// @param txSemaphore The semaphore released by this core to notify the other core.
+    Doorbell(uint32_t rxSemaphore, uint32_t txSemaphore) : m_event(), m_rx(rxSemaphore), m_tx(txSemaphore) { }
+
+    /// @brief This type cannot be copied.
+    Doorbell(const Doorbell&) = delete;
+
+    /// @brief This type cannot be moved.
+    Doorbell(Doorbell&&) = delete;
+
+    /// @brief Disables the notifications on going out of scope.
+    ~Doorbell();
+
+    /// @brief Activates the receive semaphore notification for this core. DO NOT CALL FROM ISR!
+    /// @returns True if enabled. False if the semaphore index is invalid or it is used by another doorbell.
+    bool enable(void);
+
+    /// @brief Notifies the other core by taking and releasing the transmit semaphore. ISR safe.
+    /// @returns True if the notification was sent. False if the semaphore could not be taken.
+    bool ring(void);
+
+    /// @brief Blocks the current thread until the other core rings. A ring that happened before the call is not lost. DO NOT CALL FROM ISR!
+    /// @param timeout The maximal number of RTOS ticks to wait. Default: `waitForever`.
+    /// @returns True if notified, false on timeout.
+    bool wait(TickCount timeout = waitForever);
+
+    /// @brief Dispatches the notifications to the enabled doorbells and re-activates them. Call from `HAL_HSEM_FreeCallback`.
+    /// @param semaphoreMask The mask of the released semaphores passed to the callback.
+    static void isr(uint32_t semaphoreMask);
+
+private:
+
+    static constexpr EventFlags ringBit = 1; // The event group bit signaled on ring.
+
+    EventGroup m_event; // Signaled from the HSEM interrupt.
+    uint32_t m_rx;      // Receive semaphore index.
+    uint32_t m_tx;      // Transmit semaphore index.
+
+    static inline Doorbell* m_registry[semaphores] = {}; // Enabled doorbells by the receive semaphore index.
+
+};
+
+}
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file        EventBus.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Static publish / subscribe event bus with compile-time topics, dispatched through the application thread scheduler. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "EventBus.hpp"
+#include "AppThread.hpp"
+#include "CriticalSection.hpp"
+#include "Crash.hpp"
+
+bool OS::EventBus::add(EventTopicId id, EventHandlerPointer handler, void* context, EventInvoker invoke)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    CriticalSection section;
+    if (m_subscriberCount >= maxSubscribers) return false;
+    size_t i = m_subscriberCount;
+    for (; i > 0 && m_subscribers[i - 1].id > id; --i) m_subscribers[i] = m_subscribers[i - 1];
+    m_subscribers[i] = { id, handler, context, invoke };
+    ++m_subscriberCount;
+    return true;
+}
+
+bool OS::EventBus::remove(EventTopicId id, EventHandlerPointer handler, void* context)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    CriticalSection section;
+    for (size_t i = 0; i < m_subscriberCount; ++i)
+    {
+        const Subscriber& s = m_subscribers[i];
+        if (s.id != id || s.handler != handler || s.context != context) continue;
+        for (--m_subscriberCount; i < m_subscriberCount; ++i) m_subscribers[i] = m_subscribers[i + 1];
+        m_subscribers[m_subscriberCount] = {};
+        return true;
+    }
+    return false;
+}
+
+void OS::EventBus::dispatch(EventTopicId id, const void* payload)
+{
+    size_t lower = 0, upper = m_subscriberCount;
+    while (lower < upper)
+    { // Binary search for the first subscriber of the topic.
+        size_t middle = (lower + upper) >> 1;
+        if (m_subscribers[middle].id < id) lower = middle + 1; else upper = middle;
+    }
+    for (size_t i = lower; i < m_subscriberCount && m_subscribers[i].id == id; ++i)
+    {
+        const Subscriber& s = m_subscribers[i];
+        s.invoke(s.handler, s.context, payload);
+    }
+}
+
+bool OS::EventBus::post(EventTopicId id, const void* payload, size_t size, PublishMode mode, ThreadContext context)
+{
+    if (mode == immediate && !CurrentThread::isISRContext())
+    {
+        dispatch(id, payload);
+        return true;
+    }
+    Queue& q = queue(context);
+    bool isScheduleNeeded = false;
+    {
+        CriticalSection section;
+        if (q.count >= queueSize)
+        {
+            ++m_dropped;
+            return false;
+        }
+        Event& event = q.events[q.head];
+        event.id = id;
+        std::memcpy(event.payload, payload, size);
+        q.head = (q.head + 1) % queueSize;
+        ++q.count;
+        isScheduleNeeded = !q.isScheduled;
+        q.isScheduled = true;
+    }
+    if (isScheduleNeeded) AppThread::sync(&q, drainQueue, context == frame ? frame : application);
+    return true;
+}
+
+bool OS::EventBus::latch(Latch& latch, EventTopicId id, const void* payload, size_t size)
+{
+    bool isScheduleNeeded = false;
+    {
+        CriticalSection section;
+        latch.id = id;
+        std::memcpy(latch.payload, payload, size);
+        if (!latch.isPending)
+        {
+            latch.isPending = true;
+            latch.next = m_pending;
+            m_pending = &latch;
+        }
+        isScheduleNeeded = !m_isBatchScheduled;
+        m_isBatchScheduled = true;
+    }
+    if (isScheduleNeeded) AppThread::sync(drainLatches, frame);
+    return true;
+}
+
+void OS::EventBus::drainQueue(void* queue)
+{
+    Queue& q = *static_cast<Queue*>(queue);
+    Event event;
+    for (;;)
+    {
+        {
+            CriticalSection section;
+            if (!q.count)
+            {
+                q.isScheduled = false;
+                return;
+            }
+            event = q.events[(q.head + queueSize - q.count) % queueSize];
+            --q.count;
+        }
+        dispatch(event.id, event.payload);
+    }
+}
+
+void OS::EventBus::drainLatches(void)
+{
+    Latch* pending;
+    {
+        CriticalSection section;
+        pending = m_pending;
+        m_pending = nullptr;
+        m_isBatchScheduled = false;
+    }
+    Event event;
+    while (pending)
+    {
+        {
+            CriticalSection section;
+            event.id = pending->id;
+            std::memcpy(event.payload, pending->payload, payloadSize);
+            pending->isPending = false;
+            Latch* next = pending->next;
+            pending->next = nullptr;
+            pending = next;
+        }
+        dispatch(event.id, event.payload);
+    }
+}
@@ -0,0 +1,214 @@
+/**
+ * @file        EventBus.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Static publish / subscribe event bus with compile-time topics, dispatched through the application thread scheduler. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "RTOS.hpp"
+#include "StaticClass.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifndef WTK_EVENT_SUBSCRIBERS
+#define WTK_EVENT_SUBSCRIBERS 32
+#endif
+
+#ifndef WTK_EVENT_QUEUE
+#define WTK_EVENT_QUEUE 32
+#endif
+
+#ifndef WTK_EVENT_PAYLOAD
+#define WTK_EVENT_PAYLOAD 16
+#endif
+
+namespace OS
+{
+
+using EventTopicId = uint16_t; // Event topic identifier type.
+
+/// @brief Type erased event handler pointer, cast back to the topic handler type before it's called.
+using EventHandlerPointer = void(*)(void);
+
+/// @brief Calls a type erased event handler with a type erased payload.
+using EventInvoker = void(*)(EventHandlerPointer handler, void* context, const void* payload);
+
+/// @brief Event delivery mode.
+enum PublishMode : uint32_t
+{
+    immediate,  // Handlers are called from the publishing thread before `publish` returns. From ISR the event is deferred.
+    deferred,   // The event is queued and delivered in the selected thread context.
+    batched     // Only the last value of the topic is kept and delivered on the next display frame.
+};
+
+/// @brief Defines an event topic at compile time.
+/// @tparam TId Unique topic identifier.
+/// @tparam TPayload Trivially copyable payload type, up to `WTK_EVENT_PAYLOAD` bytes.
+template<EventTopicId TId, typename TPayload>
+struct Topic final
+{
+
+    static_assert(std::is_trivially_copyable_v<TPayload>, "The event payload must be trivially copyable");
+    static_assert(sizeof(TPayload) <= WTK_EVENT_PAYLOAD, "The event payload is larger than WTK_EVENT_PAYLOAD");
+
+    static constexpr EventTopicId id = TId; // Topic identifier.
+    using Payload = TPayload;               // Payload type.
+
+    /// @brief Event handler type.
+    /// @param context A pointer passed to `EventBus::subscribe`.
+    /// @param payload Event payload.
+    using Handler = void(*)(void* context, const TPayload& payload);
+
+    /// @brief Calls the type erased handler with the type erased payload.
+    /// @param handler A handler stored in the subscriber table.
+    /// @param context A pointer passed to `EventBus::subscribe`.
+    /// @param payload Event payload pointer.
+    static void invoke(EventHandlerPointer handler, void* context, const void* payload)
+    {
+        reinterpret_cast<Handler>(handler)(context, *static_cast<const TPayload*>(payload));
+    }
+
+};
+
+/// @brief Static publish / subscribe event bus.
+/// @remarks Subscribers are kept in a static table sorted by the topic identifier, so publishing visits only the topic subscribers.
+///          Deferred events are queued per thread context and drained by a single scheduled task per context.
+///          Batched events are latched per topic, so many publications between frames are delivered once, with the last payload.
+///          Subscribe and unsubscribe from threads, preferably before the topic is published. Publish from threads or ISRs.
+class EventBus final
+{
+
+    STATIC(EventBus)
+
+public:
+
+    static constexpr size_t maxSubscribers = WTK_EVENT_SUBSCRIBERS; // Subscriber table size.
+    static constexpr size_t queueSize = WTK_EVENT_QUEUE;            // Deferred events queue size per thread context.
+    static constexpr size_t payloadSize = WTK_EVENT_PAYLOAD;        // Maximal payload size in bytes.
+
+    /// @brief Adds a handler for the topic. DO NOT CALL FROM ISR!
+    /// @tparam TTopic Topic type.
+    /// @param handler Event handler.
+    /// @param context A pointer passed to the handler. Default: `nullptr`.
+    /// @returns True if subscribed. False if the subscriber table is full.
+    template<typename TTopic>
+    static inline bool subscribe(typename TTopic::Handler handler, void* context = nullptr)
+    {
+        return add(TTopic::id, reinterpret_cast<EventHandlerPointer>(handler), context, TTopic::invoke);
+    }
+
+    /// @brief Removes a handler of the topic. DO NOT CALL FROM ISR!
+    /// @tparam TTopic Topic type.
+    /// @param handler Event handler.
+    /// @param context A pointer passed to `subscribe`. Default: `nullptr`.
+    /// @returns True if removed. False if not subscribed.
+    template<typename TTopic>
+    static inline bool unsubscribe(typename TTopic::Handler handler, void* context = nullptr)
+    {
+        return remove(TTopic::id, reinterpret_cast<EventHandlerPointer>(handler), context);
+    }
+
+    /// @brief Publishes an event. ISR safe.
+    /// @tparam TTopic Topic type.
+    /// @param payload Event payload.
+    /// @param mode Delivery mode. Default: `immediate`.
+    /// @param context The thread context for the `deferred` mode, or an ISR `immediate` publication. Default: `application`.
+    /// @returns True if delivered or queued. False if the deferred queue is full.
+    template<typename TTopic>
+    static inline bool publish(const typename TTopic::Payload& payload, PublishMode mode = immediate, ThreadContext context = application)
+    {
+        if (mode == batched) return latch<TTopic>(payload);
+        return post(TTopic::id, &payload, sizeof(payload), mode, context);
+    }
+
+    /// @returns The number of events dropped because a deferred queue was full.
+    static inline uint32_t dropped() { return m_dropped; }
+
+private:
+
+    /// @brief Subscriber table entry.
+    struct Subscriber
+    {
+        EventTopicId id;                // Topic identifier.
+        EventHandlerPointer handler;    // Type erased handler.
+        void* context;                  // Handler context.
+        EventInvoker invoke;            // Topic handler invoker.
+    };
+
+    /// @brief Deferred event.
+    struct Event
+    {
+        EventTopicId id;                                // Topic identifier.
+        alignas(std::max_align_t) uint8_t payload[payloadSize]; // Payload copy.
+    };
+
+    /// @brief Deferred events queue of a thread context.
+    struct Queue
+    {
+        Event events[queueSize];    // Event ring.
+        size_t head;                // The index of the next event to write.
+        size_t count;               // The number of queued events.
+        bool isScheduled;           // True if the drain task is scheduled.
+    };
+
+    /// @brief The last batched payload of a topic.
+    struct Latch
+    {
+        Latch* next;                                    // The next pending latch.
+        EventTopicId id;                                // Topic identifier.
+        bool isPending;                                 // True if linked to the pending list.
+        alignas(std::max_align_t) uint8_t payload[payloadSize]; // The last payload.
+    };
+
+    /// @brief Inserts a subscriber keeping the table sorted.
+    static bool add(EventTopicId id, EventHandlerPointer handler, void* context, EventInvoker invoke);
+
+    /// @brief Removes a subscriber keeping the table sorted.
+    static bool remove(EventTopicId id, EventHandlerPointer handler, void* context);
+
+    /// @brief Calls all handlers of the topic.
+    static void dispatch(EventTopicId id, const void* payload);
+
+    /// @brief Dispatches the event now, or queues it for the target context.
+    static bool post(EventTopicId id, const void* payload, size_t size, PublishMode mode, ThreadContext context);
+
+    /// @brief Stores the batched payload in the topic latch and links the latch to the pending list.
+    static bool latch(Latch& latch, EventTopicId id, const void* payload, size_t size);
+
+    /// @brief Stores the batched payload of the topic.
+    template<typename TTopic>
+    static inline bool latch(const typename TTopic::Payload& payload)
+    {
+        return latch(m_latch<TTopic>, TTopic::id, &payload, sizeof(payload));
+    }
+
+    /// @brief Delivers the queued events. Scheduled in the queue thread context.
+    /// @param queue Queue pointer.
+    static void drainQueue(void* queue);
+
+    /// @brief Delivers the pending batched events. Scheduled in the frame context.
+    static void drainLatches(void);
+
+    /// @returns The queue of the thread context.
+    static inline Queue& queue(ThreadContext context) { return m_queues[context == frame ? 1 : 0]; }
+
+    template<typename TTopic>
+    static inline Latch m_latch = {};                           // Batched payload storage of the topic.
+
+    static inline Subscriber m_subscribers[maxSubscribers] = {}; // Subscriber table sorted by the topic identifier.
+    static inline size_t m_subscriberCount = 0;                  // The number of subscribers.
+    static inline Queue m_queues[2] = {};                        // Deferred events queues: application, frame.
+    static inline Latch* m_pending = nullptr;                    // Pending batched events list.
+    static inline bool m_isBatchScheduled = false;               // True if the batched events drain task is scheduled.
+    static inline uint32_t m_dropped = 0;                        // The number of dropped events.
+
+};
+
+}
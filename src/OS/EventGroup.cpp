@@ -30,14 +30,21 @@ bool OS::EventGroup::signal(EventFlags bits)
     return result == TX_SUCCESS;
 }
 
+bool OS::EventGroup::clear(EventFlags bits)
+{
+    init();
+    auto result = tx_event_flags_set(&m_controlBlock, ~bits, TX_AND);
+    return result == TX_SUCCESS;
+}
+
 OS::EventFlags OS::EventGroup::wait(EventFlags bits, WaitOptions options, TickCount timeout)
 {
     init();
     if (CurrentThread::isISRContext()) Crash::here(); // Can't wait in ISR!
     EventFlags actualFlags;
-    UINT txOption = (options & noClear)
-        ? ((options & waitAny) ? TX_OR : (options & waitAll) ? TX_AND : 0)
-        : ((options & waitAny) ? TX_OR_CLEAR : (options & waitAll) ? TX_AND_CLEAR : 0);
+    UINT txOption = (options & waitAll)
+        ? ((options & noClear) ? TX_AND : TX_AND_CLEAR)
+        : ((options & noClear) ? TX_OR : TX_OR_CLEAR);
     auto result = tx_event_flags_get(&m_controlBlock, bits, txOption, &actualFlags, timeout);
     return result == TX_SUCCESS ? actualFlags : 0;
 }
@@ -75,6 +82,14 @@ bool OS::EventGroup::signal(EventFlags bits)
     return xEventGroupSetBits(m_handle, bits) == pdPASS;
 }
 
+bool OS::EventGroup::clear(EventFlags bits)
+{
+    init();
+    if (CurrentThread::isISRContext()) return xEventGroupClearBitsFromISR(m_handle, bits) == pdPASS;
+    xEventGroupClearBits(m_handle, bits);
+    return true;
+}
+
 OS::EventFlags OS::EventGroup::wait(EventFlags bits, WaitOptions options, TickCount timeout)
 {
     init();
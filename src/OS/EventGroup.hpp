@@ -32,6 +32,11 @@ public:
     /// @returns True if the bits was set successfully.
     bool signal(EventFlags bits);
 
+    /// @brief Clears the specified bits of this event group.
+    /// @param bits Bits to clear.
+    /// @returns True if the bits was cleared successfully.
+    bool clear(EventFlags bits);
+
     /// @brief Blocks the current thread until the requested bits are set.
     /// @param bits Bits to wait.
     /// @param options Wait options.
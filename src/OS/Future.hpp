@@ -0,0 +1,320 @@
+/**
+ * @file        Future.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Static storage promise and future pair allowing a thread to block until a value is provided
+ *              by another thread or ISR. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "EventGroup.hpp"
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace OS
+{
+
+/// @brief Common part of the promise, signals the settlement with an event group bit.
+/// @remarks The first settlement wins, the other settlers get false. Any number of threads can wait for it.
+///          The state is a lock-free atomic on the cores with exclusive access instructions (Cortex-M3 and up),
+///          which is required for settling from ISR.
+class PromiseBase
+{
+
+public:
+
+    /// @brief Promise state.
+    enum State : uint32_t
+    {
+        pending,    // The promise is not settled yet.
+        fulfilled,  // The value was provided.
+        broken,     // The producer failed to provide the value.
+        settling    // The value is being stored, reported as `pending`.
+    };
+
+    /// @brief The event group bit used by the promises that have their own event group.
+    static constexpr EventFlags defaultBit = 1;
+
+    /// @brief Creates a pending promise that uses its own event group.
+    PromiseBase() : m_ownGroup(std::in_place), m_group(&*m_ownGroup), m_bit(defaultBit), m_state(pending) { }
+
+    /// @brief Creates a pending promise that signals a bit of a shared event group.
+    /// @remarks Promises sharing the same event group can be awaited with a single system call.
+    /// @param group Shared event group reference.
+    /// @param bit A single bit unique for this promise within the event group.
+    PromiseBase(EventGroup& group, EventFlags bit) : m_ownGroup(std::nullopt), m_group(&group), m_bit(bit), m_state(pending) { }
+
+    /// @brief This type cannot be copied.
+    PromiseBase(const PromiseBase&) = delete;
+
+    /// @brief This type cannot be moved.
+    PromiseBase(PromiseBase&&) = delete;
+
+    /// @returns The current state of the promise.
+    inline State state() const
+    {
+        State current = m_state.load(std::memory_order_acquire);
+        return current == settling ? pending : current;
+    }
+
+    /// @returns True if the promise is either fulfilled or broken.
+    inline bool isSettled() const { return state() != pending; }
+
+    /// @returns The event group used to signal the settlement.
+    inline EventGroup& group() const { return *m_group; }
+
+    /// @returns The event group bit used to signal the settlement.
+    inline EventFlags bit() const { return m_bit; }
+
+    /// @brief Settles the promise as broken, releasing the waiting threads without a value. ISR safe.
+    /// @returns True if the promise was pending and is broken now.
+    inline bool fail() { return settle(broken); }
+
+    /// @brief Returns the promise to the pending state, so it can be reused. DO NOT CALL WHILE ANY THREAD WAITS FOR IT!
+    inline void reset()
+    {
+        m_state.store(pending, std::memory_order_release);
+        m_group->clear(m_bit);
+    }
+
+    /// @brief Blocks the current thread until the promise is settled. DO NOT CALL FROM ISR!
+    /// @param timeout The maximal number of RTOS ticks to wait. Default: `waitForever`.
+    /// @returns True if the promise is settled, false on timeout.
+    bool wait(TickCount timeout = waitForever)
+    {
+        if (isSettled()) return true;
+        m_group->wait(m_bit, waitAny | noClear, timeout); // The bit stays set for other waiters until `reset`.
+        return isSettled();
+    }
+
+protected:
+
+    /// @brief Claims the promise for the settlement, so only one settler can store the value.
+    /// @returns True if the promise was pending and is claimed now.
+    bool claim()
+    {
+        State expected = pending;
+        return m_state.compare_exchange_strong(expected, settling, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /// @brief Publishes the final state of a claimed promise and signals the event group bit.
+    /// @param state Final state.
+    /// @returns True if signaled.
+    bool publish(State state)
+    {
+        m_state.store(state, std::memory_order_release); // Orders the value store before the state.
+        return m_group->signal(m_bit);
+    }
+
+    /// @brief Sets the final state and signals the event group bit.
+    /// @param state Final state.
+    /// @returns True if the promise was pending and is settled now.
+    bool settle(State state) { return claim() && publish(state); }
+
+private:
+    std::optional<EventGroup> m_ownGroup;   // An event group constructed only when no shared group is provided.
+    EventGroup* m_group;                    // The event group used to signal the settlement.
+    EventFlags m_bit;                       // The event group bit used to signal the settlement.
+    std::atomic<State> m_state;             // Current state, set before the event group bit is signaled.
+
+};
+
+/// @brief Common part of the future, a non-owning handle to a promise.
+class FutureBase
+{
+
+public:
+
+    /// @brief Creates an invalid future, not associated with any promise.
+    FutureBase() : m_promise() { }
+
+    /// @brief Creates a future for the promise.
+    /// @param promise Promise reference.
+    FutureBase(PromiseBase& promise) : m_promise(&promise) { }
+
+    /// @returns True if the future is associated with a promise.
+    inline bool valid() const { return m_promise != nullptr; }
+
+    /// @returns True if the associated promise is settled (it is safe to call `get` without blocking).
+    inline bool isReady() const { return m_promise && m_promise->isSettled(); }
+
+    /// @returns The associated promise state, `broken` for an invalid future.
+    inline PromiseBase::State state() const { return m_promise ? m_promise->state() : PromiseBase::broken; }
+
+    /// @brief Blocks the current thread until the associated promise is settled. DO NOT CALL FROM ISR!
+    /// @param timeout The maximal number of RTOS ticks to wait. Default: `waitForever`.
+    /// @returns True if the promise is settled, false on timeout or for an invalid future.
+    inline bool wait(TickCount timeout = waitForever) const { return m_promise && m_promise->wait(timeout); }
+
+    /// @returns The associated promise pointer, `nullptr` for an invalid future.
+    inline PromiseBase* promise() const { return m_promise; }
+
+protected:
+    PromiseBase* m_promise; // Associated promise pointer.
+
+};
+
+template<typename T> class Future;
+
+/// @brief The producer side of a value passed once between threads.
+/// @tparam T Value type.
+template<typename T>
+class Promise final : public PromiseBase
+{
+
+public:
+
+    /// @brief Creates a pending promise that uses its own event group.
+    Promise() : PromiseBase(), m_value() { }
+
+    /// @brief Creates a pending promise that signals a bit of a shared event group.
+    /// @param group Shared event group reference.
+    /// @param bit A single bit unique for this promise within the event group.
+    Promise(EventGroup& group, EventFlags bit) : PromiseBase(group, bit), m_value() { }
+
+    /// @returns A future that can be used to wait for the value.
+    inline Future<T> future() { return Future<T>(*this); }
+
+    /// @brief Stores the value and releases the waiting threads. ISR safe.
+    /// @param value The value to pass.
+    /// @returns True if the promise was pending and is fulfilled now.
+    bool setValue(const T& value)
+    {
+        if (!claim()) return false;
+        m_value = value;
+        return publish(fulfilled);
+    }
+
+friend class Future<T>;
+private:
+    T m_value; // Value storage.
+
+};
+
+/// @brief The producer side of a completion signal passed once between threads.
+template<>
+class Promise<void> final : public PromiseBase
+{
+
+public:
+
+    /// @brief Creates a pending promise that uses its own event group.
+    Promise() : PromiseBase() { }
+
+    /// @brief Creates a pending promise that signals a bit of a shared event group.
+    /// @param group Shared event group reference.
+    /// @param bit A single bit unique for this promise within the event group.
+    Promise(EventGroup& group, EventFlags bit) : PromiseBase(group, bit) { }
+
+    /// @returns A future that can be used to wait for the completion.
+    inline Future<void> future();
+
+    /// @brief Releases the waiting threads. ISR safe.
+    /// @returns True if the promise was pending and is fulfilled now.
+    inline bool set() { return settle(fulfilled); }
+
+};
+
+/// @brief The consumer side of a value passed once between threads.
+/// @tparam T Value type.
+template<typename T>
+class Future final : public FutureBase
+{
+
+public:
+
+    /// @brief Creates an invalid future, not associated with any promise.
+    Future() : FutureBase() { }
+
+    /// @brief Creates a future for the promise.
+    /// @param promise Promise reference.
+    Future(Promise<T>& promise) : FutureBase(promise) { }
+
+    /// @brief Blocks the current thread until the value is provided. DO NOT CALL FROM ISR!
+    /// @param timeout The maximal number of RTOS ticks to wait. Default: `waitForever`.
+    /// @returns The value, or an empty value on timeout, on broken promise or for an invalid future.
+    std::optional<T> get(TickCount timeout = waitForever) const
+    {
+        if (!wait(timeout) || m_promise->state() != PromiseBase::fulfilled) return {};
+        return static_cast<Promise<T>*>(m_promise)->m_value;
+    }
+
+};
+
+/// @brief The consumer side of a completion signal passed once between threads.
+template<>
+class Future<void> final : public FutureBase
+{
+
+public:
+
+    /// @brief Creates an invalid future, not associated with any promise.
+    Future() : FutureBase() { }
+
+    /// @brief Creates a future for the promise.
+    /// @param promise Promise reference.
+    Future(Promise<void>& promise) : FutureBase(promise) { }
+
+    /// @brief Blocks the current thread until the promise is fulfilled. DO NOT CALL FROM ISR!
+    /// @param timeout The maximal number of RTOS ticks to wait. Default: `waitForever`.
+    /// @returns True if fulfilled, false on timeout, on broken promise or for an invalid future.
+    bool get(TickCount timeout = waitForever) const
+    {
+        return wait(timeout) && m_promise->state() == PromiseBase::fulfilled;
+    }
+
+};
+
+inline Future<void> Promise<void>::future() { return Future<void>(*this); }
+
+/// @brief Blocks the current thread until all the futures are settled. DO NOT CALL FROM ISR!
+/// @remarks Pending futures sharing an event group are awaited with one system call using the combined bit mask.
+/// @param futures An array of future pointers.
+/// @param count The number of elements in the array.
+/// @param timeout The maximal number of RTOS ticks to wait for all futures. Default: `waitForever`.
+/// @returns True if all futures are settled, false on timeout or if any of the futures is invalid.
+inline bool waitForAll(FutureBase* const* futures, size_t count, TickCount timeout = waitForever)
+{
+    const TickCount start = getTick();
+    for (;;)
+    {
+        EventGroup* group = nullptr;
+        EventFlags mask = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            PromiseBase* promise = futures[i]->promise();
+            if (!promise) return false;
+            if (promise->isSettled()) continue;
+            if (!group) group = &promise->group();
+            if (group == &promise->group()) mask |= promise->bit();
+        }
+        if (!group) return true; // Nothing left pending.
+        TickCount remaining = waitForever;
+        if (timeout != waitForever)
+        {
+            TickCount elapsed = getTick() - start;
+            if (elapsed >= timeout) return false;
+            remaining = timeout - elapsed;
+        }
+        group->wait(mask, waitAll | noClear, remaining);
+    }
+}
+
+/// @brief Blocks the current thread until all the futures are settled. DO NOT CALL FROM ISR!
+/// @tparam TFutures Future types.
+/// @param timeout The maximal number of RTOS ticks to wait for all futures.
+/// @param futures Future references.
+/// @returns True if all futures are settled, false on timeout or if any of the futures is invalid.
+template<typename... TFutures>
+inline bool waitForAll(TickCount timeout, TFutures&... futures)
+{
+    FutureBase* list[] = { static_cast<FutureBase*>(&futures)... };
+    return waitForAll(list, sizeof...(futures), timeout);
+}
+
+}
@@ -0,0 +1,110 @@
+/**
+ * @file        InterCoreChannel.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Bidirectional message channel between two cores, made of two shared rings and doorbell notifications. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Doorbell.hpp"
+#include "SharedRing.hpp"
+
+#if defined(HSEM)
+
+namespace OS
+{
+
+/// @brief Shared memory part of a bidirectional message channel between the primary and the secondary core.
+/// @remarks Place the instance in a `NOLOAD` section of the memory shared by both cores, at the same address for both images.
+///          The primary core must call `reset` before the secondary core starts using the channel.
+/// @tparam TSize Data buffer size of each direction in bytes, a power of 2.
+template<size_t TSize>
+struct InterCoreChannel final
+{
+
+    SharedRing<TSize> primaryToSecondary;   // Written by the primary core.
+    SharedRing<TSize> secondaryToPrimary;   // Written by the secondary core.
+
+    /// @brief Empties both directions.
+    void reset()
+    {
+        primaryToSecondary.reset();
+        secondaryToPrimary.reset();
+    }
+
+};
+
+/// @brief One core's end of an inter-core channel. Lives in the core local memory.
+/// @tparam TSize Data buffer size of each direction in bytes, a power of 2.
+template<size_t TSize>
+class InterCorePort final
+{
+
+public:
+
+    /// @brief Creates a port for one side of the channel.
+    /// @param channel The shared channel reference.
+    /// @param isPrimary True for the primary core port, false for the secondary core port.
+    /// @param doorbell This core's doorbell, enabled before receiving.
+    InterCorePort(InterCoreChannel<TSize>& channel, bool isPrimary, Doorbell& doorbell)
+        : m_tx(isPrimary ? channel.primaryToSecondary : channel.secondaryToPrimary),
+          m_rx(isPrimary ? channel.secondaryToPrimary : channel.primaryToSecondary),
+          m_doorbell(doorbell) { }
+
+    /// @brief Sends a message to the other core. Only one thread (or ISR) of this core may send through the port. ISR safe.
+    /// @param data Message data.
+    /// @param length Message length in bytes, up to `SharedRing<TSize>::maxLength`.
+    /// @returns True if sent. False if the message is too long or the ring is full.
+    bool send(const void* data, size_t length)
+    {
+        if (!m_tx.write(data, length)) return false;
+        m_doorbell.ring();
+        return true;
+    }
+
+    /// @brief Receives a message without blocking. Only one thread (or ISR) of this core may receive from the port. ISR safe.
+    /// @param buffer Target buffer.
+    /// @param capacity Target buffer size in bytes.
+    /// @param length Set to the message length when a message is available.
+    /// @returns True if a message was received. False if there are no messages, or the buffer is too small.
+    inline bool tryReceive(void* buffer, size_t capacity, size_t& length) { return m_rx.read(buffer, capacity, length); }
+
+    /// @brief Blocks the current thread until a message is received. DO NOT CALL FROM ISR!
+    /// @param buffer Target buffer.
+    /// @param capacity Target buffer size in bytes.
+    /// @param length Set to the message length when a message is available.
+    /// @param timeout The maximal number of RTOS ticks to wait. Default: `waitForever`.
+    /// @returns True if a message was received. False on timeout, or if the buffer is too small.
+    bool receive(void* buffer, size_t capacity, size_t& length, TickCount timeout = waitForever)
+    {
+        const TickCount start = getTick();
+        for (;;)
+        {
+            length = 0;
+            if (m_rx.read(buffer, capacity, length)) return true;
+            if (length > capacity) return false;
+            TickCount remaining = waitForever;
+            if (timeout != waitForever)
+            {
+                TickCount elapsed = getTick() - start;
+                if (elapsed >= timeout) return false;
+                remaining = timeout - elapsed;
+            }
+            m_doorbell.wait(remaining);
+        }
+    }
+
+private:
+    SharedRing<TSize>& m_tx;    // The ring written by this core.
+    SharedRing<TSize>& m_rx;    // The ring written by the other core.
+    Doorbell& m_doorbell;       // This core's doorbell.
+
+};
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include "Mutex.hpp"
 #include "CurrentThread.hpp"
 #include "Crash.hpp"
+#include "Trace.hpp"
 
 #if defined(USE_AZURE_RTOS)
 
@@ -24,10 +25,8 @@ OS::Mutex::~Mutex()
     }
 }
 
-bool OS::Mutex::acquire(TickCount timeout)
+bool OS::Mutex::take(TickCount timeout)
 {
-    if (CurrentThread::isISRContext()) return false;
-    init();
     return tx_mutex_get(&m_controlBlock, timeout) == TX_SUCCESS;
 }
 
@@ -53,10 +52,8 @@ OS::Mutex::~Mutex()
     if (m_handle) m_handle = nullptr;
 }
 
-bool OS::Mutex::acquire(TickCount timeout)
+bool OS::Mutex::take(TickCount timeout)
 {
-    if (CurrentThread::isISRContext()) return false;
-    init();
     return xSemaphoreTake(m_handle, timeout) == pdTRUE;
 }
 
@@ -74,3 +71,19 @@ void OS::Mutex::init(void)
 }
 
 #endif
+
+bool OS::Mutex::acquire(TickCount timeout)
+{
+    if (CurrentThread::isISRContext()) return false;
+    init();
+#if WTK_TRACE_RECORDS
+    if (take(0)) return true; // Uncontended, nothing to trace.
+    if (!timeout) return false;
+    WTK_TRACE_OBJECT(TraceRecord::mutexWait, this);
+    bool acquired = take(timeout);
+    WTK_TRACE_OBJECT(TraceRecord::mutexAcquired, this, acquired);
+    return acquired;
+#else
+    return take(timeout);
+#endif
+}
@@ -41,6 +41,11 @@ private:
     /// @brief Performs the lazy initialization of the control block if required.
     void init(void);
 
+    /// @brief Takes the mutex with the RTOS call.
+    /// @param timeout The time to wait for the mutex to be released expressed in RTOS ticks.
+    /// @returns True if the mutex was taken.
+    bool take(TickCount timeout);
+
 #if defined(USE_AZURE_RTOS)
     TX_MUTEX m_controlBlock;
     bool m_isCreated;
@@ -0,0 +1,84 @@
+/**
+ * @file        Parallel.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Fork-join data parallel loops executed on a fixed pool of worker threads. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Parallel.hpp"
+#include "CurrentThread.hpp"
+#include "Crash.hpp"
+#include <cstdint>
+
+void OS::Parallel::run(size_t begin, size_t end, size_t grain, void* context, ParallelBody body)
+{
+    if (CurrentThread::isISRContext() || !body) Crash::here();
+    if (begin >= end) return;
+    if (!grain) grain = 1;
+    size_t chunks = (end - begin - 1) / grain + 1;
+    if (chunks < 2 || isParticipant())
+    { // Nothing to share or a nested loop: the workers are busy, process serially.
+        body(context, begin, end, 0);
+        return;
+    }
+    size_t helpers = chunks - 1 < workers ? chunks - 1 : workers;
+    EventFlags helperBits = (static_cast<EventFlags>(1) << helpers) - 1;
+    m_mutex.acquire();
+    if (!m_isStarted) start();
+    m_owner = CurrentThread::get().handle();
+    m_body = body;
+    m_context = context;
+    m_end = end;
+    m_grain = grain;
+    m_next.store(begin);
+    m_start.signal(helperBits);
+    process(0);
+    m_done.wait(helperBits, waitAll);
+    m_owner = nullptr;
+    m_body = nullptr;
+    m_context = nullptr;
+    m_mutex.release();
+}
+
+void OS::Parallel::start(void)
+{
+    for (size_t i = 0; i < workers; ++i)
+        m_threads[i].start(reinterpret_cast<void*>(i), workerEntry, "Parallel", ThreadPriority::normal);
+    m_isStarted = true;
+}
+
+bool OS::Parallel::isParticipant(void)
+{
+    ThreadHandle current = CurrentThread::get().handle();
+    if (!current) return false;
+    if (current == m_owner) return true;
+    for (const auto& thread : m_threads) if (thread.handle() == current) return true;
+    return false;
+}
+
+void OS::Parallel::process(size_t participant)
+{
+    for (;;)
+    {
+        size_t i0 = m_next.fetch_add(m_grain);
+        if (i0 >= m_end) return;
+        size_t i1 = i0 + m_grain;
+        if (i1 > m_end || i1 < i0) i1 = m_end;
+        m_body(m_context, i0, i1, participant);
+    }
+}
+
+void OS::Parallel::workerEntry(ThreadArg arg)
+{
+    size_t index = (uintptr_t)arg;
+    EventFlags bit = static_cast<EventFlags>(1) << index;
+    for (;;)
+    {
+        m_start.wait(bit, waitAny);
+        process(index + 1);
+        m_done.signal(bit);
+    }
+}
@@ -0,0 +1,143 @@
+/**
+ * @file        Parallel.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Fork-join data parallel loops executed on a fixed pool of worker threads. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "EventGroup.hpp"
+#include "Mutex.hpp"
+#include "StaticClass.hpp"
+#include "Thread.hpp"
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#ifndef WTK_OS_PARALLEL_WORKERS
+#define WTK_OS_PARALLEL_WORKERS 1
+#endif
+
+namespace OS
+{
+
+/// @brief A function processing the index range [`begin`, `end`) of a parallel loop.
+/// @param context Loop context pointer.
+/// @param begin The first index of the range.
+/// @param end The index after the last index of the range.
+/// @param participant The index of the thread processing the range, 0 is the calling thread.
+using ParallelBody = void(*)(void* context, size_t begin, size_t end, size_t participant);
+
+/// @brief Fixed pool of worker threads executing data parallel loops together with the calling thread.
+/// @remarks Workers are started on the first use. Only one loop runs at a time, other callers block until it completes.
+///          Work is distributed dynamically: each participant claims the next `grain` sized chunk when it's done with the previous one.
+class Parallel final
+{
+
+    STATIC(Parallel)
+
+public:
+
+    static constexpr size_t workers = WTK_OS_PARALLEL_WORKERS;  // The number of worker threads.
+    static constexpr size_t participants = workers + 1;         // The number of threads processing a loop, including the caller.
+
+    static_assert(workers > 0 && workers <= 24, "WTK_OS_PARALLEL_WORKERS must be in 1..24 range");
+
+    /// @brief Processes the index range split into chunks on the worker threads and the calling thread. Blocks until all chunks are done.
+    /// @remarks Called from a loop body (nested), the range is processed serially on the current thread. DO NOT CALL FROM ISR!
+    /// @param begin The first index.
+    /// @param end The index after the last index.
+    /// @param grain The maximal number of indices processed by one body call. Zero is treated as 1.
+    /// @param context A pointer passed to the body.
+    /// @param body A function processing a chunk.
+    static void run(size_t begin, size_t end, size_t grain, void* context, ParallelBody body);
+
+private:
+
+    /// @brief Starts the worker threads.
+    static void start(void);
+
+    /// @returns True if the current thread is a worker or the thread currently running a loop.
+    static bool isParticipant(void);
+
+    /// @brief Claims and processes chunks until the range is exhausted.
+    /// @param participant The index of the thread processing the chunks.
+    static void process(size_t participant);
+
+    /// @brief Worker thread loop, waits for the start signal, processes chunks and signals completion.
+    /// @param arg Worker index.
+    static void workerEntry(ThreadArg arg);
+
+    static inline Thread m_threads[workers] = {};   // Worker threads.
+    static inline Mutex m_mutex = {};               // Serializes the loops.
+    static inline EventGroup m_start = {};          // Worker start bits.
+    static inline EventGroup m_done = {};           // Worker completion bits.
+    static inline std::atomic<size_t> m_next = 0;   // The first index of the next chunk to claim.
+    static inline size_t m_end = 0;                 // The index after the last index of the current loop.
+    static inline size_t m_grain = 1;               // The chunk size of the current loop.
+    static inline void* m_context = nullptr;        // The current loop context.
+    static inline ParallelBody m_body = nullptr;    // The current loop body.
+    static inline ThreadHandle m_owner = nullptr;   // The thread running the current loop.
+    static inline bool m_isStarted = false;         // True if the worker threads are started.
+
+};
+
+/// @brief Calls the function for each index in [`begin`, `end`) range, using the worker threads and the calling thread. DO NOT CALL FROM ISR!
+/// @tparam TFunction A callable type taking a `size_t` index.
+/// @param begin The first index.
+/// @param end The index after the last index.
+/// @param grain The number of indices processed by a thread at once. Large enough to amortize the chunk claim cost.
+/// @param function The function to call for each index. The calls are concurrent, the order is not specified.
+template<typename TFunction>
+inline void parallelFor(size_t begin, size_t end, size_t grain, TFunction&& function)
+{
+    using F = std::remove_reference_t<TFunction>;
+    ParallelBody body = [](void* context, size_t i0, size_t i1, size_t)
+    {
+        F& f = *static_cast<F*>(context);
+        for (size_t i = i0; i < i1; ++i) f(i);
+    };
+    Parallel::run(begin, end, grain, const_cast<void*>(static_cast<const void*>(&function)), body);
+}
+
+/// @brief Reduces the [`begin`, `end`) range to a single value, using the worker threads and the calling thread. DO NOT CALL FROM ISR!
+/// @remarks Each participant accumulates its chunks into its own partial value, the partials are combined by the caller.
+///          Since the chunk to thread assignment varies, the `combine` operation should be associative.
+/// @tparam T Result type.
+/// @tparam TMap A callable type `T(size_t begin, size_t end, T accumulator)` that accumulates a chunk.
+/// @tparam TCombine A callable type `T(T a, T b)` that combines two partial values.
+/// @param begin The first index.
+/// @param end The index after the last index.
+/// @param grain The number of indices processed by a thread at once.
+/// @param identity The initial value for each partial, neutral for the `combine` operation.
+/// @param map Chunk accumulating function.
+/// @param combine Partial values combining function.
+/// @returns The combined value.
+template<typename T, typename TMap, typename TCombine>
+inline T parallelReduce(size_t begin, size_t end, size_t grain, T identity, TMap&& map, TCombine&& combine)
+{
+    using M = std::remove_reference_t<TMap>;
+    struct Context
+    {
+        M* map;
+        T* partials;
+    };
+    T partials[Parallel::participants];
+    for (auto& partial : partials) partial = identity;
+    Context context { &map, partials };
+    ParallelBody body = [](void* pointer, size_t i0, size_t i1, size_t participant)
+    {
+        Context& c = *static_cast<Context*>(pointer);
+        c.partials[participant] = (*c.map)(i0, i1, c.partials[participant]);
+    };
+    Parallel::run(begin, end, grain, &context, body);
+    T result = identity;
+    for (const auto& partial : partials) result = combine(result, partial);
+    return result;
+}
+
+}
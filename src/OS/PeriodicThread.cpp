@@ -0,0 +1,115 @@
+/**
+ * @file        PeriodicThread.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       RTOS thread released on absolute periodic deadlines, with rate monotonic priorities and timing statistics. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "PeriodicThread.hpp"
+#include "CurrentThread.hpp"
+#include "Crash.hpp"
+
+OS::PeriodicThread::PeriodicThread()
+    : m_thread(), m_statisticsMutex(), m_statistics(), m_period(), m_deadline(), m_priority(topPriority), m_context(), m_body() { }
+
+OS::PeriodicThread::~PeriodicThread()
+{
+    if (m_thread.active()) stop();
+}
+
+bool OS::PeriodicThread::start(TickCount period, void* context, PeriodicBody body, const char* name, TickCount deadline)
+{
+    if (CurrentThread::isISRContext() || !body) Crash::here();
+    if (m_thread.active() || !period) return false;
+    m_registryMutex.acquire();
+    PeriodicThread** slot = nullptr;
+    for (auto& entry : m_registry) if (!entry) { slot = &entry; break; }
+    if (!slot)
+    {
+        m_registryMutex.release();
+        return false;
+    }
+    m_period = period;
+    m_deadline = deadline ? deadline : period;
+    m_context = context;
+    m_body = body;
+    resetStatistics();
+    *slot = this;
+    assignPriorities();
+    m_thread.start(this, entry, name, m_priority);
+    m_registryMutex.release();
+    return true;
+}
+
+void OS::PeriodicThread::stop(void)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    m_registryMutex.acquire();
+    if (m_thread.active())
+    { // The statistics mutex is taken, so the thread is not terminated while holding it.
+        m_statisticsMutex.acquire();
+        m_thread.terminate();
+        m_statisticsMutex.release();
+    }
+    for (auto& entry : m_registry) if (entry == this) entry = nullptr;
+    assignPriorities();
+    m_registryMutex.release();
+}
+
+OS::PeriodicThread::Statistics OS::PeriodicThread::statistics(void)
+{
+    m_statisticsMutex.acquire();
+    Statistics copy = m_statistics;
+    m_statisticsMutex.release();
+    return copy;
+}
+
+void OS::PeriodicThread::resetStatistics(void)
+{
+    m_statisticsMutex.acquire();
+    m_statistics = {};
+    m_statisticsMutex.release();
+}
+
+void OS::PeriodicThread::entry(ThreadArg arg)
+{
+    PeriodicThread& self = *reinterpret_cast<PeriodicThread*>(arg);
+    TickCount release = getTick();
+    for (;;)
+    {
+        TickCount started = getTick();
+        self.m_body(self.m_context);
+        TickCount finished = getTick();
+        self.m_statisticsMutex.acquire();
+        ++self.m_statistics.cycles;
+        if (finished - release > self.m_deadline) ++self.m_statistics.misses;
+        self.m_statistics.jitter.add(started - release);
+        self.m_statistics.execution.add(finished - started);
+        self.m_statisticsMutex.release();
+        delayUntil(release, self.m_period);
+    }
+}
+
+void OS::PeriodicThread::assignPriorities(void)
+{
+    PeriodicThread* sorted[maxThreads];
+    size_t count = 0;
+    for (auto thread : m_registry)
+    { // Insertion sort by period, shortest first.
+        if (!thread) continue;
+        size_t i = count++;
+        for (; i > 0 && sorted[i - 1]->m_period > thread->m_period; --i) sorted[i] = sorted[i - 1];
+        sorted[i] = thread;
+    }
+    size_t rank = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0 && sorted[i]->m_period != sorted[i - 1]->m_period) ++rank;
+        ThreadPriority priority = ThreadPriority(topPriority) - static_cast<int>(rank);
+        if (sorted[i]->m_thread.active() && !(priority == sorted[i]->m_priority)) sorted[i]->m_thread.changePriority(priority);
+        sorted[i]->m_priority = priority;
+    }
+}
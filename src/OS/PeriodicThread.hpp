@@ -0,0 +1,146 @@
+/**
+ * @file        PeriodicThread.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       RTOS thread released on absolute periodic deadlines, with rate monotonic priorities and timing statistics. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Mutex.hpp"
+#include "Thread.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#ifndef WTK_OS_PERIODIC_THREADS
+#define WTK_OS_PERIODIC_THREADS 8
+#endif
+
+#ifndef WTK_OS_PERIODIC_BINS
+#define WTK_OS_PERIODIC_BINS 8
+#endif
+
+namespace OS
+{
+
+/// @brief A function called once per period from the periodic thread context.
+/// @param context A pointer passed to the `PeriodicThread::start` method.
+using PeriodicBody = void(*)(void* context);
+
+/// @brief Represents a RTOS thread that calls its body on absolute periodic release times, so the cycles do not drift.
+/// @remarks Priorities of all started periodic threads are assigned in rate monotonic order:
+///          the shorter the period, the higher the priority, starting from `topPriority` down towards idle.
+///          Each cycle the thread records the start jitter, the execution time and the deadline misses.
+class PeriodicThread final
+{
+
+public:
+
+    static constexpr size_t maxThreads = WTK_OS_PERIODIC_THREADS;   // The maximal number of started periodic threads.
+    static constexpr size_t bins = WTK_OS_PERIODIC_BINS;            // The number of histogram bins.
+    static constexpr ThreadPriority::Preset topPriority = ThreadPriority::high; // The priority of the thread with the shortest period.
+
+    static_assert(bins > 1, "WTK_OS_PERIODIC_BINS must be at least 2");
+
+    /// @brief Logarithmic histogram of tick values. Bin 0 counts zeros, bin `n` counts [2^(n-1), 2^n) values, the last bin counts the rest.
+    struct Histogram
+    {
+
+        uint32_t counts[bins];  // Sample counts per bin.
+        TickCount max;          // The maximal sample value.
+
+        /// @brief Adds a sample to the histogram.
+        /// @param value Sample value in system ticks.
+        void add(TickCount value)
+        {
+            if (value > max) max = value;
+            size_t bin = 0;
+            while (value && bin < bins - 1) { value >>= 1; ++bin; }
+            ++counts[bin];
+        }
+
+        /// @returns The upper bound (exclusive) of the bin in system ticks, `waitForever` for the last bin.
+        /// @param bin Bin index.
+        static constexpr TickCount upperBound(size_t bin) { return bin < bins - 1 ? static_cast<TickCount>(1) << bin : waitForever; }
+
+    };
+
+    /// @brief Timing statistics of a periodic thread.
+    struct Statistics
+    {
+        uint32_t cycles;        // The number of completed cycles.
+        uint32_t misses;        // The number of cycles completed after the deadline.
+        Histogram jitter;       // The delays between the release times and the actual cycle starts.
+        Histogram execution;    // The body execution times.
+    };
+
+    /// @brief Creates an empty periodic thread container for the thread to be started later.
+    PeriodicThread();
+
+    /// @brief This type cannot be copied.
+    PeriodicThread(const PeriodicThread&) = delete;
+
+    /// @brief This type cannot be moved.
+    PeriodicThread(PeriodicThread&&) = delete;
+
+    /// @brief Stops the thread on going out of scope.
+    ~PeriodicThread();
+
+    /// @brief Starts the periodic thread and re-assigns the priorities of all started periodic threads. DO NOT CALL FROM ISR!
+    /// @param period The number of system ticks between releases. Must be greater than zero.
+    /// @param context A pointer passed to the body.
+    /// @param body A function called once per period.
+    /// @param name Thread name, default `nullptr`.
+    /// @param deadline The number of system ticks after the release the body must complete in, zero for the period. Default: 0.
+    /// @returns True if started. False if already started, if the period is zero or if `WTK_OS_PERIODIC_THREADS` threads are already started.
+    bool start(TickCount period, void* context, PeriodicBody body, const char* name = nullptr, TickCount deadline = 0);
+
+    /// @brief Terminates the thread and re-assigns the priorities of the remaining periodic threads.
+    /// @remarks DO NOT CALL FROM ISR OR FROM THE PERIODIC THREAD BODY!
+    void stop(void);
+
+    /// @returns A value indicating that the thread is started.
+    inline bool active() const { return m_thread.active(); }
+
+    /// @returns The number of system ticks between releases.
+    inline TickCount period() const { return m_period; }
+
+    /// @returns The number of system ticks after the release the body must complete in.
+    inline TickCount deadline() const { return m_deadline; }
+
+    /// @returns The rate monotonic priority assigned to the thread.
+    inline ThreadPriority priority() const { return m_priority; }
+
+    /// @returns A consistent copy of the current timing statistics. DO NOT CALL FROM ISR!
+    Statistics statistics(void);
+
+    /// @brief Clears the timing statistics. DO NOT CALL FROM ISR!
+    void resetStatistics(void);
+
+private:
+
+    /// @brief Thread loop, calls the body on each release and records the timing of the cycle.
+    /// @param arg This periodic thread pointer.
+    static void entry(ThreadArg arg);
+
+    /// @brief Assigns the priorities of all started periodic threads by their periods.
+    static void assignPriorities(void);
+
+    Thread m_thread;            // RTOS thread.
+    Mutex m_statisticsMutex;    // Guards the statistics.
+    Statistics m_statistics;    // Timing statistics.
+    TickCount m_period;         // The number of system ticks between releases.
+    TickCount m_deadline;       // The number of system ticks after the release the body must complete in.
+    ThreadPriority m_priority;  // The assigned priority.
+    void* m_context;            // A pointer passed to the body.
+    PeriodicBody m_body;        // A function called once per period.
+
+    static inline PeriodicThread* m_registry[maxThreads] = {};  // Started periodic threads.
+    static inline Mutex m_registryMutex = {};                   // Guards the registry.
+
+};
+
+}
@@ -24,6 +24,14 @@ void OS::delay(TickCount ticks)
     if (tx_thread_sleep(ticks) != TX_SUCCESS) Crash::here();
 }
 
+void OS::delayUntil(TickCount& previousWake, TickCount period)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    previousWake += period;
+    TickCount remaining = previousWake - tx_time_get();
+    if (remaining > 0 && remaining <= period && tx_thread_sleep(remaining) != TX_SUCCESS) Crash::here();
+}
+
 OS::TickCount OS::getTick(void)
 {
     return tx_time_get();
@@ -49,6 +57,12 @@ void OS::delay(TickCount ticks)
     vTaskDelay(ticks);
 }
 
+void OS::delayUntil(TickCount& previousWake, TickCount period)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    vTaskDelayUntil(&previousWake, period);
+}
+
 OS::TickCount OS::getTick(void)
 {
     return CurrentThread::isISRContext() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
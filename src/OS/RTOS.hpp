@@ -68,14 +68,23 @@ enum ThreadContext : uint32_t
 /// @brief Task identifier integer. Zero means empty.
 using TaskId = uint32_t;
 
-/// @brief Options for the `EventGroup::wait` method.
+/// @brief Options for the `EventGroup::wait` method. Combine with `|`, like `waitAny | noClear`.
 enum WaitOptions : uint32_t
 {
-    waitAny,    // Wait for any flag.
-    waitAll,    // Wait for all flags.
-    noClear     // Do not clear flags which have been specified to wait for.
+    waitAny = 0,    // Wait for any flag (default).
+    waitAll = 1,    // Wait for all flags.
+    noClear = 2     // Do not clear flags which have been specified to wait for.
 };
 
+/// @brief Combines the wait options.
+/// @param a Wait options.
+/// @param b Wait options.
+/// @returns Combined wait options.
+constexpr WaitOptions operator|(WaitOptions a, WaitOptions b)
+{
+    return static_cast<WaitOptions>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
 /// @brief A `TickCount` value indicating no timeout or infinite wait time.
 static constexpr TickCount waitForever = static_cast<TickCount>(-1);
 
@@ -86,6 +95,12 @@ void yield(void);
 /// @param ticks The number of system ticks to wait.
 void delay(TickCount ticks);
 
+/// @brief Blocks the current thread until the absolute time `previousWake + period`, so a periodic loop does not accumulate drift.
+/// @remarks If the wake time has already passed, returns immediately. DO NOT CALL FROM ISR!
+/// @param previousWake The tick the thread was last released at. Updated to the next release tick.
+/// @param period The number of system ticks between releases.
+void delayUntil(TickCount& previousWake, TickCount period);
+
 /// @brief Gets the number of system ticks since the current thread was started.
 /// @returns The number of system ticks since the current thread was started.
 TickCount getTick(void);
@@ -0,0 +1,103 @@
+/**
+ * @file        Selector.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Multiplexes many event sources on one event group, so a thread can wait for any of them and handle all ready ones per wakeup. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Selector.hpp"
+#include "CriticalSection.hpp"
+#include "CurrentThread.hpp"
+#include "Crash.hpp"
+
+OS::Selector::Source OS::Selector::add(TickCount period)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    CriticalSection section;
+    for (Source source = 0; source < maxSources; ++source)
+    {
+        if (m_used & bit(source)) continue;
+        SourceState& state = m_sources[source];
+        state.count.store(0);
+        state.period = period;
+        state.next = getTick() + period;
+        m_used = m_used | bit(source);
+        return source;
+    }
+    return invalid;
+}
+
+void OS::Selector::remove(Source& source)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    if (source >= maxSources) return;
+    {
+        CriticalSection section;
+        m_used = m_used & ~bit(source);
+        m_sources[source].count.store(0);
+        m_sources[source].period = 0;
+    }
+    m_group.clear(bit(source));
+    source = invalid;
+}
+
+bool OS::Selector::signal(Source source, uint32_t count)
+{
+    if (source >= maxSources || !(m_used & bit(source))) return false;
+    m_sources[source].count.fetch_add(count);
+    return m_group.signal(bit(source));
+}
+
+OS::Selector::ReadySet OS::Selector::wait(TickCount timeout)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    if (!m_used) return 0; // No source could ever become ready.
+    const TickCount start = getTick();
+    for (;;)
+    {
+        TickCount now = getTick();
+        TickCount timerWait = updateTimers(now);
+        ReadySet set = ready();
+        if (set) return set;
+        TickCount remaining = waitForever;
+        if (timeout != waitForever)
+        {
+            TickCount elapsed = now - start;
+            if (elapsed >= timeout) return 0;
+            remaining = timeout - elapsed;
+        }
+        if (timerWait < remaining) remaining = timerWait;
+        m_group.wait(m_used, waitAny, remaining); // Clears the wake up bits, the counters tell what's pending.
+    }
+}
+
+OS::TickCount OS::Selector::updateTimers(TickCount now)
+{
+    TickCount nearest = waitForever;
+    for (Source source = 0; source < maxSources; ++source)
+    {
+        SourceState& state = m_sources[source];
+        if (!(m_used & bit(source)) || !state.period) continue;
+        TickCount late = now - state.next;
+        if (late < static_cast<TickCount>(waitForever >> 1))
+        { // The event is due, count all the periods that elapsed.
+            uint32_t events = late / state.period + 1;
+            state.next += events * state.period;
+            state.count.fetch_add(events);
+        }
+        TickCount left = state.next - now;
+        if (left < nearest) nearest = left;
+    }
+    return nearest;
+}
+
+OS::Selector::ReadySet OS::Selector::ready() const
+{
+    ReadySet set = 0;
+    for (Source source = 0; source < maxSources; ++source)
+        if ((m_used & bit(source)) && m_sources[source].count.load()) set |= bit(source);
+    return set;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file        Selector.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Multiplexes many event sources on one event group, so a thread can wait for any of them and handle all ready ones per wakeup. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "EventGroup.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OS
+{
+
+/// @brief Multiplexes many event sources on one event group, so a thread can wait for any of them and handle all ready ones per wakeup.
+/// @remarks Each source has an event group bit and an event counter. Producers (queue writers, ISRs, other threads) call `signal`,
+///          the consumer thread calls `wait` to get the set of ready sources, then `take` to get and reset the number of events of each source.
+///          Periodic timer sources are handled by the waiting thread itself, they need no other thread nor a scheduled task.
+///          There is no semaphore source: `OS::Semaphore` can only be observed by blocking on it, so the code releasing
+///          the semaphore should `signal` a selector source instead. Each `signal` counts, like a counting semaphore.
+///          Only one thread should wait on a selector.
+class Selector final
+{
+
+public:
+
+    using Source = uint32_t;                            // Source identifier, also its bit index.
+    using ReadySet = EventFlags;                        // A set of ready sources, one bit per source.
+    static constexpr Source invalid = 0xFFFFFFFFul;     // Not a valid source.
+    static constexpr size_t maxSources = 24;            // The number of event group bits available on all supported RTOS.
+
+    /// @brief Creates a selector without sources.
+    Selector() : m_group(), m_sources(), m_used() { }
+
+    /// @brief This type cannot be copied.
+    Selector(const Selector&) = delete;
+
+    /// @brief This type cannot be moved.
+    Selector(Selector&&) = delete;
+
+    /// @brief Adds a source signaled with the `signal` method. DO NOT CALL FROM ISR!
+    /// @returns Source identifier, or `invalid` if all sources are used.
+    inline Source add() { return add(0); }
+
+    /// @brief Adds a periodic timer source, ready every `period` system ticks since now. DO NOT CALL FROM ISR!
+    /// @param period The number of system ticks between the timer events.
+    /// @returns Source identifier, or `invalid` if all sources are used or the period is zero.
+    inline Source addTimer(TickCount period) { return period ? add(period) : invalid; }
+
+    /// @brief Removes the source. Pending events are discarded. DO NOT CALL FROM ISR!
+    /// @param source Source identifier reference. Set to `invalid`.
+    void remove(Source& source);
+
+    /// @brief Records events of the source and wakes the waiting thread. ISR safe.
+    /// @param source Source identifier.
+    /// @param count The number of events to record. Default: 1.
+    /// @returns True if signaled. False if the source is not valid.
+    bool signal(Source source, uint32_t count = 1);
+
+    /// @brief Blocks the current thread until any source is ready. Returns immediately if any source has pending events. DO NOT CALL FROM ISR!
+    /// @param timeout The maximal number of system ticks to wait. Default: `waitForever`.
+    /// @returns A set of the sources with pending events, empty on timeout or when no source is added.
+    ReadySet wait(TickCount timeout = waitForever);
+
+    /// @brief Gets and resets the number of pending events of the source, to handle them in one batch. ISR safe.
+    /// @param source Source identifier.
+    /// @returns The number of events recorded since the last `take`.
+    inline uint32_t take(Source source) { return source < maxSources ? m_sources[source].count.exchange(0) : 0; }
+
+    /// @returns The number of pending events of the source without resetting it.
+    /// @param source Source identifier.
+    inline uint32_t pending(Source source) const { return source < maxSources ? m_sources[source].count.load() : 0; }
+
+    /// @returns True if the source is in the ready set.
+    /// @param set Ready set returned by `wait`.
+    /// @param source Source identifier.
+    static constexpr bool isReady(ReadySet set, Source source) { return source < maxSources && (set & bit(source)); }
+
+private:
+
+    /// @brief Source state.
+    struct SourceState
+    {
+        std::atomic<uint32_t> count;    // The number of pending events.
+        TickCount period;               // Timer period, zero for a signaled source.
+        TickCount next;                 // The next timer event tick.
+    };
+
+    /// @returns The event group bit of the source.
+    /// @param source Source identifier.
+    static constexpr EventFlags bit(Source source) { return static_cast<EventFlags>(1) << source; }
+
+    /// @brief Allocates a source.
+    /// @param period Timer period, zero for a signaled source.
+    Source add(TickCount period);
+
+    /// @brief Records the timer events that are due.
+    /// @param now Current system tick.
+    /// @returns The number of system ticks to the nearest timer event, `waitForever` if there are no timers.
+    TickCount updateTimers(TickCount now);
+
+    /// @returns The set of the sources with pending events.
+    ReadySet ready() const;
+
+    EventGroup m_group;                     // Wakes the waiting thread.
+    SourceState m_sources[maxSources];      // Source states.
+    volatile EventFlags m_used;             // The set of allocated sources.
+
+};
+
+}
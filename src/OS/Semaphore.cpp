@@ -11,6 +11,7 @@
 #include "Semaphore.hpp"
 #include "CurrentThread.hpp"
 #include "Crash.hpp"
+#include "Trace.hpp"
 
 #if defined(USE_AZURE_RTOS)
 
@@ -30,7 +31,9 @@ bool OS::Semaphore::wait(TickCount timeout)
     if (m_isTaken || CurrentThread::isISRContext()) Crash::here();
     init();
     m_isTaken = true;
+    WTK_TRACE_OBJECT(TraceRecord::semaphoreWait, this);
     bool ok = tx_semaphore_get(&m_controlBlock, timeout) == TX_SUCCESS;
+    WTK_TRACE_OBJECT(TraceRecord::semaphoreTaken, this, ok);
     m_isTaken = false;
     return ok;
 }
@@ -38,6 +41,7 @@ bool OS::Semaphore::wait(TickCount timeout)
 bool OS::Semaphore::release(void)
 {
     if (!m_isCreated || !m_isTaken) return false;
+    WTK_TRACE_OBJECT(TraceRecord::semaphoreGive, this);
     return tx_semaphore_put(&m_controlBlock) == TX_SUCCESS;
 }
 
@@ -63,7 +67,9 @@ bool OS::Semaphore::wait(TickCount timeout)
     if (m_isTaken || CurrentThread::isISRContext()) Crash::here();
     init();
     m_isTaken = true;
+    WTK_TRACE_OBJECT(TraceRecord::semaphoreWait, this);
     bool ok = xSemaphoreTake(m_handle, timeout) == pdTRUE;
+    WTK_TRACE_OBJECT(TraceRecord::semaphoreTaken, this, ok);
     m_isTaken = false;
     return ok;
 }
@@ -71,6 +77,7 @@ bool OS::Semaphore::wait(TickCount timeout)
 bool OS::Semaphore::release(void)
 {
     if (!m_isTaken) return false;
+    WTK_TRACE_OBJECT(TraceRecord::semaphoreGive, this);
     if (CurrentThread::isISRContext())
     {
         BaseType_t pxHigherPriorityTaskWoken = 0;
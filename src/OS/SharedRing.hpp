@@ -0,0 +1,202 @@
+/**
+ * @file        SharedRing.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Lock-free single producer, single consumer ring of variable length messages placed in memory shared between cores. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "hal_mcu.h"
+#include "StaticClass.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace OS
+{
+
+/// @brief Cache maintenance for the memory shared with other bus masters. No-op on cores without the data cache.
+class SharedMemory final
+{
+
+    STATIC(SharedMemory)
+
+public:
+
+    static constexpr size_t cacheLine = 32; // Data cache line size in bytes.
+
+    /// @brief Writes the cached data in the address range back to the memory, so it's visible to other cores.
+    /// @param address The first byte address.
+    /// @param size The number of bytes.
+    static inline void clean(const volatile void* address, size_t size)
+    {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        uintptr_t start = align(address);
+        SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t*>(start), static_cast<int32_t>(reinterpret_cast<uintptr_t>(address) + size - start));
+#else
+        (void)address; (void)size;
+        __DMB();
+#endif
+    }
+
+    /// @brief Discards the cached data in the address range, so the next reads fetch what other cores have written.
+    /// @remarks The range is extended to whole cache lines, so it must not share a cache line with data written by this core.
+    /// @param address The first byte address.
+    /// @param size The number of bytes.
+    static inline void invalidate(const volatile void* address, size_t size)
+    {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        uintptr_t start = align(address);
+        SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t*>(start), static_cast<int32_t>(reinterpret_cast<uintptr_t>(address) + size - start));
+#else
+        (void)address; (void)size;
+        __DMB();
+#endif
+    }
+
+private:
+
+    /// @returns The address aligned down to the cache line boundary.
+    /// @param address Any address.
+    static inline uintptr_t align(const volatile void* address)
+    {
+        return reinterpret_cast<uintptr_t>(address) & ~static_cast<uintptr_t>(cacheLine - 1);
+    }
+
+};
+
+/// @brief Lock-free single producer, single consumer ring of variable length messages placed in memory shared between cores.
+/// @remarks The object should be placed at the same address for both cores (a dedicated `NOLOAD` linker section) and reset by one core before the other uses it.
+///          Each message is stored as a 32-bit length followed by the data padded to 4 bytes. A message never wraps,
+///          when it doesn't fit at the end of the buffer, a wrap marker is written and the message starts at the beginning.
+///          The producer and the consumer indices occupy separate cache lines, so each side writes only its own lines.
+/// @tparam TSize Data buffer size in bytes, a power of 2 and a multiple of the cache line size.
+template<size_t TSize>
+class SharedRing final
+{
+
+    static_assert(TSize >= 64 && (TSize & (TSize - 1)) == 0, "TSize must be a power of 2, at least 64");
+
+public:
+
+    static constexpr size_t maxLength = TSize / 2 - sizeof(uint32_t); // The maximal message length in bytes.
+
+    /// @brief Creates an uninitialized ring. The constructor is trivial, so no core overwrites the shared memory on startup. Call `reset` first.
+    SharedRing() = default;
+
+    /// @brief This type cannot be copied.
+    SharedRing(const SharedRing&) = delete;
+
+    /// @brief This type cannot be moved.
+    SharedRing(SharedRing&&) = delete;
+
+    /// @brief Empties the ring. Call once, from one core, before any core uses the ring.
+    void reset()
+    {
+        m_head.value = 0;
+        m_tail.value = 0;
+        SharedMemory::clean(&m_head, sizeof(m_head));
+        SharedMemory::clean(&m_tail, sizeof(m_tail));
+    }
+
+    /// @brief Copies a message to the ring. Producer side only. ISR safe.
+    /// @param data Message data.
+    /// @param length Message length in bytes, up to `maxLength`.
+    /// @returns True if the message was written. False if it is too long or there is not enough free space now.
+    bool write(const void* data, size_t length)
+    {
+        if (length > maxLength) return false;
+        const uint32_t size = entrySize(length);
+        SharedMemory::invalidate(&m_tail, sizeof(m_tail));
+        uint32_t head = m_head.value;
+        const uint32_t free = TSize - (head - m_tail.value);
+        uint32_t offset = head & mask;
+        const uint32_t padding = TSize - offset < size ? TSize - offset : 0;
+        if (padding + size > free) return false;
+        if (padding)
+        { // The message doesn't fit at the end, mark the rest of the buffer as skipped.
+            header(offset) = wrapMarker;
+            SharedMemory::clean(&m_data[offset], sizeof(uint32_t));
+            head += padding;
+            offset = 0;
+        }
+        header(offset) = static_cast<uint32_t>(length);
+        std::memcpy(&m_data[offset + sizeof(uint32_t)], data, length);
+        SharedMemory::clean(&m_data[offset], size);
+        m_head.value = head + size;
+        SharedMemory::clean(&m_head, sizeof(m_head));
+        return true;
+    }
+
+    /// @brief Copies the oldest message from the ring and removes it. Consumer side only. ISR safe.
+    /// @param buffer Target buffer.
+    /// @param capacity Target buffer size in bytes.
+    /// @param length Set to the message length when a message is available.
+    /// @returns True if a message was read. False if the ring is empty, or the buffer is too small (the message stays in the ring).
+    bool read(void* buffer, size_t capacity, size_t& length)
+    {
+        SharedMemory::invalidate(&m_head, sizeof(m_head));
+        const uint32_t head = m_head.value;
+        uint32_t tail = m_tail.value;
+        if (head == tail) return false;
+        uint32_t offset = tail & mask;
+        SharedMemory::invalidate(&m_data[offset], sizeof(uint32_t));
+        if (header(offset) == wrapMarker)
+        { // Skip to the beginning, the producer always writes a message after the marker.
+            tail += TSize - offset;
+            offset = 0;
+            m_tail.value = tail;
+            SharedMemory::clean(&m_tail, sizeof(m_tail));
+            SharedMemory::invalidate(&m_data[0], sizeof(uint32_t));
+        }
+        length = header(offset);
+        if (length > capacity) return false;
+        SharedMemory::invalidate(&m_data[offset], entrySize(length));
+        std::memcpy(buffer, &m_data[offset + sizeof(uint32_t)], length);
+        m_tail.value = tail + entrySize(length);
+        SharedMemory::clean(&m_tail, sizeof(m_tail));
+        return true;
+    }
+
+    /// @returns True if there are no messages in the ring. Any side.
+    bool isEmpty() const
+    {
+        SharedMemory::invalidate(&m_head, sizeof(m_head));
+        SharedMemory::invalidate(&m_tail, sizeof(m_tail));
+        return m_head.value == m_tail.value;
+    }
+
+private:
+
+    static constexpr uint32_t mask = TSize - 1;             // Buffer offset mask.
+    static constexpr uint32_t wrapMarker = 0xFFFFFFFFul;    // A length value marking the skipped end of the buffer.
+
+    /// @brief A free running buffer index, alone in its cache line.
+    struct alignas(SharedMemory::cacheLine) Index
+    {
+        volatile uint32_t value;
+    };
+
+    /// @returns The number of bytes taken by a message of the specified length, including the header and the padding.
+    /// @param length Message length in bytes.
+    static constexpr uint32_t entrySize(size_t length)
+    {
+        return static_cast<uint32_t>(sizeof(uint32_t) + ((length + 3) & ~static_cast<size_t>(3)));
+    }
+
+    /// @returns A reference to the message header at the offset.
+    /// @param offset Buffer offset.
+    inline volatile uint32_t& header(uint32_t offset) { return *reinterpret_cast<volatile uint32_t*>(&m_data[offset]); }
+
+    Index m_head;                                       // Producer index: the offset of the next message to write.
+    Index m_tail;                                       // Consumer index: the offset of the next message to read.
+    alignas(SharedMemory::cacheLine) uint8_t m_data[TSize]; // Message buffer.
+
+};
+
+}
@@ -0,0 +1,331 @@
+/**
+ * @file        StateMachine.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Hierarchical state machine engine driven by compile-time state and transition tables. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Timeout.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace OS
+{
+
+using StateId = uint8_t;    // State index in the state table.
+using EventId = uint8_t;    // Event index, from 0 to the configured event count.
+
+static constexpr StateId noState = 0xFF;    // Marks no parent, no initial child, or an internal transition target.
+static constexpr EventId noEvent = 0xFF;    // Marks no timeout event.
+
+/// @brief State table entry.
+/// @tparam TContext The type of the object passed to the actions and the guards.
+template<typename TContext>
+struct StateDefinition
+{
+    StateId parent;                 // Parent state, `noState` for a top level state.
+    StateId initial;                // The child entered after this state is entered, `noState` for a leaf state.
+    void (*entry)(TContext&);       // Entry action or `nullptr`.
+    void (*exit)(TContext&);        // Exit action or `nullptr`.
+    double timeout;                 // Time in seconds after the entry to raise the `timeoutEvent`, zero for none.
+    EventId timeoutEvent;           // The event raised when the state timeout elapses, `noEvent` for none.
+};
+
+/// @brief Transition table entry.
+/// @remarks Several transitions of the same state and event are tried in the table order, the first one with a passing guard fires.
+///          Events not handled by a state are handled by its ancestors.
+/// @tparam TContext The type of the object passed to the actions and the guards.
+template<typename TContext>
+struct TransitionDefinition
+{
+    StateId source;                 // The state that handles the event.
+    EventId event;                  // Triggering event.
+    StateId target;                 // Target state, `noState` for an internal transition (the action only, no exit and entry).
+    bool (*guard)(TContext&);       // Condition that must be true for the transition to fire, or `nullptr`.
+    void (*action)(TContext&);      // Transition action called between the exits and the entries, or `nullptr`.
+};
+
+/// @brief Hierarchical state machine engine driven by compile-time state and transition tables.
+/// @remarks Transitions are external: the states are exited up to (not including) the lowest common ancestor of the source and the target,
+///          then entered down to the target and further through the `initial` children to a leaf state.
+///          A transition to the source itself, or to its ancestor, exits and re-enters that state.
+///          Dispatch uses a precomputed [state][event] table of the first matching transition index, no virtual calls nor table searches.
+///          The machine is not thread safe, dispatch events from the application thread, where the state timeouts are delivered.
+///          Do not dispatch from the actions, use `AppThread::sync` to post follow-up events.
+///          Each nesting level has its own timer, so the timeouts of the active ancestors keep running while their children change.
+/// @tparam TContext The type of the object passed to the actions and the guards.
+/// @tparam TTables A type with `static constexpr` members: `eventCount`, `states[]` (StateDefinition) and `transitions[]` (TransitionDefinition).
+template<typename TContext, typename TTables>
+class StateMachine final
+{
+
+public:
+
+    static constexpr size_t stateCount = std::size(TTables::states);            // The number of states.
+    static constexpr size_t transitionCount = std::size(TTables::transitions);  // The number of transitions.
+    static constexpr size_t eventCount = TTables::eventCount;                   // The number of events.
+
+    static_assert(stateCount > 0 && stateCount < noState, "The state count must be in 1..254 range");
+    static_assert(eventCount > 0 && eventCount < noEvent, "The event count must be in 1..254 range");
+    static_assert(transitionCount < 0xFFFF, "Too many transitions");
+
+    /// @brief Creates a state machine that is not started yet.
+    /// @param context The object passed to the actions and the guards.
+    StateMachine(TContext& context) : m_context(context), m_state(noState), m_isBusy(), m_timers()
+    {
+        for (auto& timer : m_timers) timer.machine = this;
+    }
+
+    /// @brief This type cannot be copied.
+    StateMachine(const StateMachine&) = delete;
+
+    /// @brief This type cannot be moved.
+    StateMachine(StateMachine&&) = delete;
+
+    /// @brief Enters the state with all its ancestors, then its initial children.
+    /// @param state The state to start in.
+    /// @returns True if started. False if already started or the state is invalid.
+    bool start(StateId state)
+    {
+        if (m_state != noState || state >= stateCount || m_isBusy) return false;
+        m_isBusy = true;
+        enter(state, noState);
+        m_isBusy = false;
+        return true;
+    }
+
+    /// @brief Exits all active states, the machine can be started again.
+    void stop()
+    {
+        if (m_state == noState || m_isBusy) return;
+        m_isBusy = true;
+        exit(noState);
+        m_isBusy = false;
+    }
+
+    /// @brief Fires the first transition of the current state or its ancestors that matches the event and its guard passes.
+    /// @param event Event identifier.
+    /// @returns True if a transition fired. False if the event was not handled, the machine is not started or it is busy.
+    bool dispatch(EventId event)
+    {
+        if (event >= eventCount || m_state == noState || m_isBusy) return false;
+        StateId state = m_state;
+        while (state != noState)
+        {
+            Index first = m_tables.lookup[state][event];
+            if (first == noTransition) return false;
+            for (Index i = first; i != noTransition; i = m_tables.next[i])
+            {
+                const TransitionDefinition<TContext>& transition = TTables::transitions[i];
+                if (transition.guard && !transition.guard(m_context)) continue;
+                m_isBusy = true;
+                fire(transition);
+                m_isBusy = false;
+                return true;
+            }
+            state = TTables::states[TTables::transitions[first].source].parent; // All guards failed, try the ancestors.
+        }
+        return false;
+    }
+
+    /// @returns The current (leaf) state, `noState` if not started.
+    inline StateId state() const { return m_state; }
+
+    /// @returns True if the state is the current state or its ancestor.
+    /// @param state State identifier.
+    bool isIn(StateId state) const
+    {
+        for (StateId s = m_state; s != noState; s = TTables::states[s].parent) if (s == state) return true;
+        return false;
+    }
+
+private:
+
+    using Index = uint16_t;                             // Transition index type.
+    static constexpr Index noTransition = 0xFFFF;       // Marks no matching transition.
+
+    /// @brief Precomputed dispatch tables.
+    struct Tables
+    {
+        Index lookup[stateCount][eventCount];   // The first transition handling the event in the state or its nearest ancestor.
+        Index next[transitionCount];            // The next transition of the same source and event.
+        uint8_t depth[stateCount];              // State nesting level, 0 for top level states.
+        bool isValid;                           // True if the tables are consistent.
+    };
+
+    /// @returns The dispatch tables computed from the state and transition tables.
+    static constexpr Tables build()
+    {
+        Tables t {};
+        t.isValid = true;
+        for (size_t s = 0; s < stateCount; ++s)
+        {
+            size_t depth = 0;
+            for (StateId p = TTables::states[s].parent; p != noState; p = TTables::states[p].parent)
+            {
+                if (p >= stateCount || ++depth >= stateCount) { t.isValid = false; return t; }
+            }
+            t.depth[s] = static_cast<uint8_t>(depth);
+            StateId initial = TTables::states[s].initial;
+            if (initial != noState && (initial >= stateCount || TTables::states[initial].parent != s)) t.isValid = false;
+        }
+        for (size_t i = 0; i < transitionCount; ++i)
+        {
+            const auto& transition = TTables::transitions[i];
+            if (transition.source >= stateCount || transition.event >= eventCount ||
+                (transition.target != noState && transition.target >= stateCount)) { t.isValid = false; return t; }
+            t.next[i] = noTransition;
+            for (size_t j = i + 1; j < transitionCount; ++j)
+            {
+                if (TTables::transitions[j].source == transition.source && TTables::transitions[j].event == transition.event)
+                {
+                    t.next[i] = static_cast<Index>(j);
+                    break;
+                }
+            }
+        }
+        for (size_t s = 0; s < stateCount; ++s)
+        {
+            for (size_t e = 0; e < eventCount; ++e)
+            {
+                t.lookup[s][e] = noTransition;
+                for (StateId owner = static_cast<StateId>(s); owner != noState && t.lookup[s][e] == noTransition; owner = TTables::states[owner].parent)
+                {
+                    for (size_t i = 0; i < transitionCount; ++i)
+                    {
+                        if (TTables::transitions[i].source == owner && TTables::transitions[i].event == e)
+                        {
+                            t.lookup[s][e] = static_cast<Index>(i);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        return t;
+    }
+
+    static constexpr Tables m_tables = build(); // Precomputed dispatch tables.
+
+    static_assert(m_tables.isValid, "Invalid state machine tables: check parents, initial children, transition states and events");
+
+    /// @returns The number of the state nesting levels.
+    static constexpr size_t levels()
+    {
+        size_t count = 0;
+        for (size_t s = 0; s < stateCount; ++s) if (m_tables.depth[s] >= count) count = m_tables.depth[s] + 1;
+        return count;
+    }
+
+    static constexpr size_t levelCount = levels();  // The number of the state nesting levels, one timer each.
+
+    /// @brief State timeout timer of one nesting level.
+    struct LevelTimer final : Timeout
+    {
+        LevelTimer() : Timeout(0.0, this, timeout), machine(), state(noState) { }
+        StateMachine* machine;  // The state machine pointer.
+        StateId state;          // The state of the level that set the timer, `noState` if none.
+    };
+
+    /// @returns The lowest state that contains both states, excluding the states themselves when one contains the other.
+    /// @param a State identifier.
+    /// @param b State identifier.
+    static StateId commonAncestor(StateId a, StateId b)
+    {
+        while (m_tables.depth[a] > m_tables.depth[b]) a = TTables::states[a].parent;
+        while (m_tables.depth[b] > m_tables.depth[a]) b = TTables::states[b].parent;
+        if (a == b) return TTables::states[a].parent;
+        while (a != b)
+        {
+            a = TTables::states[a].parent;
+            b = TTables::states[b].parent;
+        }
+        return a;
+    }
+
+    /// @brief Executes the transition.
+    /// @param transition Transition reference.
+    void fire(const TransitionDefinition<TContext>& transition)
+    {
+        if (transition.target == noState)
+        {
+            if (transition.action) transition.action(m_context);
+            return;
+        }
+        StateId ancestor = commonAncestor(transition.source, transition.target);
+        exit(ancestor);
+        if (transition.action) transition.action(m_context);
+        enter(transition.target, ancestor);
+    }
+
+    /// @brief Exits the current state and its ancestors up to, not including, the specified ancestor.
+    /// @param ancestor The first state not to exit, `noState` to exit all.
+    void exit(StateId ancestor)
+    {
+        while (m_state != noState && m_state != ancestor)
+        {
+            const StateDefinition<TContext>& definition = TTables::states[m_state];
+            if (definition.exit) definition.exit(m_context);
+            LevelTimer& timer = m_timers[m_tables.depth[m_state]];
+            if (timer.state == m_state)
+            {
+                timer.clear();
+                timer.state = noState;
+            }
+            m_state = definition.parent;
+        }
+    }
+
+    /// @brief Enters the states from below the ancestor down to the target, then the initial children of the target.
+    /// @param target Target state.
+    /// @param ancestor The lowest active state that stays active, `noState` if none.
+    void enter(StateId target, StateId ancestor)
+    {
+        StateId path[stateCount];
+        size_t length = 0;
+        for (StateId s = target; s != ancestor && s != noState; s = TTables::states[s].parent) path[length++] = s;
+        while (length) enterState(path[--length]);
+        for (StateId s = TTables::states[target].initial; s != noState; s = TTables::states[s].initial) enterState(s);
+    }
+
+    /// @brief Makes the state current, calls its entry action and sets its timeout.
+    /// @param state State identifier.
+    void enterState(StateId state)
+    {
+        const StateDefinition<TContext>& definition = TTables::states[state];
+        m_state = state;
+        if (definition.entry) definition.entry(m_context);
+        if (definition.timeout > 0 && definition.timeoutEvent != noEvent)
+        {
+            LevelTimer& timer = m_timers[m_tables.depth[state]];
+            timer.clear();
+            timer.set(definition.timeout);
+            timer.state = state;
+        }
+    }
+
+    /// @brief Dispatches the timeout event of the state that set the level timer.
+    /// @param arg Level timer pointer.
+    static void timeout(void* arg)
+    {
+        LevelTimer& timer = *static_cast<LevelTimer*>(arg);
+        StateId state = timer.state;
+        if (state == noState || !timer.machine) return;
+        timer.state = noState;
+        timer.machine->dispatch(TTables::states[state].timeoutEvent);
+    }
+
+    TContext& m_context;                // The object passed to the actions and the guards.
+    StateId m_state;                    // The current leaf state.
+    bool m_isBusy;                      // True while a transition is executed.
+    LevelTimer m_timers[levelCount];    // State timeout timers, one per nesting level.
+
+};
+
+}
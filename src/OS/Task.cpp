@@ -9,6 +9,7 @@
  */
 
 #include "Task.hpp"
+#include "Trace.hpp"
 
 void OS::Task::process(ThreadContext context, size_t* immediateCount, size_t* delayedCount)
 {
@@ -16,8 +17,16 @@ void OS::Task::process(ThreadContext context, size_t* immediateCount, size_t* de
     auto tcb = m_tcb; // Since we release mutex while the task is being run, we use a snapshot of the task control block.
     m_mutex.release();
     if (!tcb.id || tcb.delayTicks || tcb.context != context) return;
+    RunningAction& running = m_running[context < contexts ? context : none];
+    running.action = tcb.action;
+    running.binding = tcb.binding;
+    running.since = getTick();
+    running.id = tcb.id;
+    WTK_TRACE(TraceRecord::taskBegin, tcb.id, context);
     if (tcb.binding) tcb.action.binding(tcb.binding);
     else tcb.action.plain();
+    WTK_TRACE(TraceRecord::taskEnd, tcb.id, context);
+    running.id = 0;
     m_mutex.acquire();
     if (m_tcb.resetTicks)
     {
@@ -16,6 +16,15 @@
 namespace OS
 {
 
+/// @brief Describes the task action being executed in a thread context.
+struct RunningAction
+{
+    TaskId id;                      // Task identifier, zero when no action is executed.
+    OptionalBindingAction action;   // The action being executed.
+    void* binding;                  // The action argument.
+    TickCount since;                // The system tick the action was called at.
+};
+
 /// @brief Scheduled task.
 class Task final
 {
@@ -25,6 +34,19 @@ public:
     /// @brief Creates an empty task.
     Task() : m_mutex(), m_tcb() { }
 
+    /// @returns A copy of the description of the action being executed in the thread context. ISR safe.
+    /// @param context Thread context.
+    static inline RunningAction running(ThreadContext context)
+    {
+        const volatile RunningAction& source = m_running[context < contexts ? context : none];
+        RunningAction copy;
+        copy.id = source.id;
+        copy.action.plain = source.action.plain;
+        copy.binding = source.binding;
+        copy.since = source.since;
+        return copy;
+    }
+
     /// @brief Tests if the task is not empty. Thread safe.
     inline operator bool()
     {
@@ -121,6 +143,9 @@ private:
 
     static inline TaskId m_uid = 0; // Unique identifier counter.
 
+    static constexpr size_t contexts = frame + 1;           // The number of thread contexts.
+    static inline RunningAction m_running[contexts] = {};  // Actions being executed, by thread context.
+
 };
 
 }
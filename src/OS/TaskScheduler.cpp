@@ -9,6 +9,7 @@
  */
 
 #include "TaskScheduler.hpp"
+#include "Trace.hpp"
 
 OS::TaskId OS::TaskScheduler::schedule(void *arg, OptionalBindingAction action, ThreadContext context, TickCount time, TickCount reset)
 {
@@ -21,6 +22,7 @@ OS::TaskId OS::TaskScheduler::schedule(void *arg, OptionalBindingAction action,
             if (time) ++m_delayed; else ++m_immediate;
             id = task.scheduleUnsafe(arg, action, context, time, reset);
             task.unlock();
+            WTK_TRACE(TraceRecord::taskEnqueue, id, context);
             if (time)
                 m_delaySemaphore.release();
             else
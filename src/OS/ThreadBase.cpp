@@ -11,6 +11,7 @@
 #include "ThreadBase.hpp"
 #include "Crash.hpp"
 #include "CurrentThread.hpp"
+#include "ThreadLocal.hpp"
 
 #if defined(USE_AZURE_RTOS)
 
@@ -24,7 +25,9 @@ OS::ThreadPriority OS::ThreadBase::changePriority(Priority newPriority)
 
 void OS::ThreadBase::terminate(void)
 {
-    if (!m_handle || CurrentThread::isISRContext() || tx_thread_delete(m_handle) != TX_SUCCESS) Crash::here();
+    if (!m_handle || CurrentThread::isISRContext()) Crash::here();
+    ThreadLocalIndex::release(m_handle);
+    if (tx_thread_delete(m_handle) != TX_SUCCESS) Crash::here();
     m_handle = nullptr;
 }
 
@@ -40,6 +43,7 @@ OS::ThreadPriority OS::ThreadBase::changePriority(Priority newPriority)
 void OS::ThreadBase::terminate(void)
 {
     if (!m_handle || CurrentThread::isISRContext()) Crash::here();
+    ThreadLocalIndex::release(m_handle); // Before the deletion, a thread deleting itself doesn't return.
     vTaskDelete(m_handle);
     m_handle = nullptr;
 }
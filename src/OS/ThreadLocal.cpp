@@ -0,0 +1,86 @@
+/**
+ * @file        ThreadLocal.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Statically allocated per-thread storage. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "ThreadLocal.hpp"
+#include "CriticalSection.hpp"
+#include <cstdint>
+
+size_t OS::ThreadLocalIndex::allocate(ThreadHandle thread)
+{
+    CriticalSection section;
+    for (size_t i = 0; i < threads; ++i)
+    {
+        if (m_owners[i]) continue;
+        m_owners[i] = thread;
+        return i;
+    }
+    return shared; // All slots are used, increase WTK_OS_TLS_THREADS.
+}
+
+#if defined(USE_AZURE_RTOS)
+
+size_t OS::ThreadLocalIndex::current(void)
+{
+    if (CurrentThread::isISRContext()) return shared;
+    ThreadHandle thread = tx_thread_identify();
+    if (!thread) return shared;
+    for (size_t i = 0; i < threads; ++i) if (m_owners[i] == thread) return i;
+    return allocate(thread);
+}
+
+void OS::ThreadLocalIndex::release(void)
+{
+    if (CurrentThread::isISRContext()) return;
+    ThreadHandle thread = tx_thread_identify();
+    if (thread) release(thread);
+}
+
+void OS::ThreadLocalIndex::release(ThreadHandle thread)
+{
+    CriticalSection section;
+    for (auto& owner : m_owners) if (owner == thread) owner = nullptr;
+}
+
+#elif defined(USE_FREE_RTOS)
+
+#if configNUM_THREAD_LOCAL_STORAGE_POINTERS <= WTK_OS_TLS_INDEX
+#error configNUM_THREAD_LOCAL_STORAGE_POINTERS must be greater than WTK_OS_TLS_INDEX.
+#endif
+
+size_t OS::ThreadLocalIndex::current(void)
+{
+    if (CurrentThread::isISRContext() || xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) return shared;
+    ThreadHandle thread = xTaskGetCurrentTaskHandle();
+    if (!thread) return shared;
+    uintptr_t stored = reinterpret_cast<uintptr_t>(pvTaskGetThreadLocalStoragePointer(thread, WTK_OS_TLS_INDEX));
+    if (stored) return stored - 1;
+    size_t index = allocate(thread);
+    vTaskSetThreadLocalStoragePointer(thread, WTK_OS_TLS_INDEX, reinterpret_cast<void*>(index + 1));
+    return index;
+}
+
+void OS::ThreadLocalIndex::release(void)
+{
+    if (CurrentThread::isISRContext() || xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) return;
+    release(xTaskGetCurrentTaskHandle());
+}
+
+void OS::ThreadLocalIndex::release(ThreadHandle thread)
+{
+    if (!thread) return;
+    uintptr_t stored = reinterpret_cast<uintptr_t>(pvTaskGetThreadLocalStoragePointer(thread, WTK_OS_TLS_INDEX));
+    if (!stored) return;
+    vTaskSetThreadLocalStoragePointer(thread, WTK_OS_TLS_INDEX, nullptr);
+    if (stored - 1 >= threads) return; // The thread used the shared slot.
+    CriticalSection section;
+    m_owners[stored - 1] = nullptr;
+}
+
+#endif
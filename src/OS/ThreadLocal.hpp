@@ -0,0 +1,116 @@
+/**
+ * @file        ThreadLocal.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Statically allocated per-thread storage. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "RTOS.hpp"
+#include "StaticClass.hpp"
+#include <cstddef>
+
+#ifndef WTK_OS_TLS_THREADS
+#define WTK_OS_TLS_THREADS 16
+#endif
+
+#ifndef WTK_OS_TLS_INDEX
+#define WTK_OS_TLS_INDEX 0
+#endif
+
+namespace OS
+{
+
+/// @brief Assigns a small unique slot index to each thread accessing a `ThreadLocal` value.
+/// @remarks On FreeRTOS the index is kept in the thread local storage pointer `WTK_OS_TLS_INDEX`, so the lookup is a single read.
+///          On ThreadX the index is found by the thread control block address in the slot owners table.
+///          ISRs and the code running before the scheduler starts share the last slot.
+///          The threads started when all slots are taken share the last slot too, so size `WTK_OS_TLS_THREADS` for all threads.
+///          `ThreadBase::terminate` frees the slot of the terminated thread.
+class ThreadLocalIndex final
+{
+
+    STATIC(ThreadLocalIndex)
+
+public:
+
+    static constexpr size_t threads = WTK_OS_TLS_THREADS;  // The number of threads that can have own slots.
+    static constexpr size_t shared = threads;               // The slot shared by ISRs and the code running without a thread.
+    static constexpr size_t slots = threads + 1;            // The total number of slots.
+
+    /// @returns The slot index of the current thread, assigned on the first call. ISR safe.
+    static size_t current(void);
+
+    /// @brief Frees the slot of the current thread, so it can be assigned to another thread.
+    /// @remarks The values stored in the slot are not reset.
+    static void release(void);
+
+    /// @brief Frees the slot of the thread, so it can be assigned to another thread. DO NOT CALL FROM ISR!
+    /// @remarks Called by `ThreadBase::terminate`. The values stored in the slot are not reset.
+    /// @param thread Thread handle.
+    static void release(ThreadHandle thread);
+
+private:
+
+    /// @brief Assigns a free slot to the thread.
+    /// @param thread Thread handle.
+    /// @returns Slot index, `shared` if all slots are used.
+    static size_t allocate(ThreadHandle thread);
+
+    static inline ThreadHandle m_owners[threads] = {}; // Threads owning the slots.
+
+};
+
+/// @brief A value that has a separate instance for each thread.
+/// @remarks The storage for all slots is allocated statically with the instance.
+/// @tparam T Value type.
+template<typename T>
+class ThreadLocal final
+{
+
+public:
+
+    /// @brief Creates default initialized values for all threads.
+    constexpr ThreadLocal() : m_values() { }
+
+    /// @brief Creates values initialized with the same value for all threads.
+    /// @param initial Initial value.
+    constexpr ThreadLocal(const T& initial) : m_values()
+    {
+        for (auto& value : m_values) value = initial;
+    }
+
+    /// @brief This type cannot be copied.
+    ThreadLocal(const ThreadLocal&) = delete;
+
+    /// @brief This type cannot be moved.
+    ThreadLocal(ThreadLocal&&) = delete;
+
+    /// @returns The current thread value reference.
+    inline T& get() { return m_values[ThreadLocalIndex::current()]; }
+
+    /// @returns The current thread value reference.
+    inline operator T&() { return get(); }
+
+    /// @returns The current thread value pointer.
+    inline T* operator->() { return &get(); }
+
+    /// @brief Sets the current thread value.
+    /// @param value New value.
+    /// @returns This reference.
+    inline ThreadLocal& operator=(const T& value)
+    {
+        get() = value;
+        return *this;
+    }
+
+private:
+    T m_values[ThreadLocalIndex::slots]; // Values by thread slot index.
+
+};
+
+}
@@ -28,19 +28,16 @@ OS::Timeout::~Timeout()
 
 void OS::Timeout::set()
 {
-    if (m_taskId || !m_ticks) return;
-    m_taskId = m_binding
-        ? AppThread::delay(m_ticks, m_binding, m_action.binding)
-        : AppThread::delay(m_ticks, m_action.plain);
+    if (m_taskId || !m_ticks || !m_action) return;
+    m_taskId = AppThread::delay(m_ticks, this, elapsed);
 }
 
 void OS::Timeout::set(double seconds)
 {
-    if (seconds <= 0 || m_taskId || !m_ticks) return;
-    m_ticks = WTK_OS_TICKS_PER_SECOND * seconds;
-    m_taskId = m_binding
-        ? AppThread::delay(m_ticks, m_binding, m_action.binding)
-        : AppThread::delay(m_ticks, m_action.plain);
+    TickCount ticks = WTK_OS_TICKS_PER_SECOND * seconds;
+    if (seconds <= 0 || m_taskId || !ticks) return;
+    m_ticks = ticks;
+    set();
 }
 
 void OS::Timeout::reset()
@@ -53,3 +50,11 @@ void OS::Timeout::clear()
 {
     AppThread::cancel(m_taskId);
 }
+
+void OS::Timeout::elapsed(void* arg)
+{
+    Timeout& timeout = *static_cast<Timeout*>(arg);
+    timeout.m_taskId = 0;
+    if (timeout.m_binding) timeout.m_action.binding(timeout.m_binding);
+    else timeout.m_action.plain();
+}
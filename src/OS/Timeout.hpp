@@ -55,7 +55,15 @@ public:
     /// @brief Clears the timeout, so the action will not be called again until `set` or `reset` method is called.
     void clear();
 
+    /// @returns True if the timeout is set and the action was not called yet.
+    inline bool isSet() const { return m_taskId != 0; }
+
 protected:
+
+    /// @brief Marks the timeout as elapsed, so it can be set again, then calls the action.
+    /// @param arg Timeout pointer.
+    static void elapsed(void* arg);
+
     TaskId m_taskId;                // Timeout task identifier.
     TickCount m_ticks;              // A time interval in RTOS ticks to call the associated action.
     OptionalBindingAction m_action; // An action to call after the timeout elapses.
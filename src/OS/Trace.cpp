@@ -0,0 +1,72 @@
+/**
+ * @file        Trace.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Scheduler trace recorder storing binary event records in a static ring. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Trace.hpp"
+#include "CriticalSection.hpp"
+#include "CurrentThread.hpp"
+#include "Crash.hpp"
+
+void OS::Trace::start(void)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+    if (!m_overhead) measure();
+    m_recording.store(true);
+}
+
+void OS::Trace::clear(void)
+{
+    CriticalSection section;
+    m_head.store(0);
+    for (auto& r : m_ring) r = {};
+}
+
+size_t OS::Trace::snapshot(TraceRecord* buffer, size_t capacity)
+{
+    if (!buffer || !capacity) return 0;
+    bool recording = m_recording.exchange(false);
+    uint32_t head = m_head.load();
+    size_t count = head < records ? head : records;
+    if (count > capacity) count = capacity;
+    uint32_t first = head - static_cast<uint32_t>(count);
+    for (size_t i = 0; i < count; ++i) buffer[i] = m_ring[(first + i) & (records - 1)];
+    if (recording) m_recording.store(true);
+    return count;
+}
+
+uint32_t OS::Trace::frequency(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    return SystemCoreClock;
+#else
+    return WTK_OS_TICKS_PER_SECOND;
+#endif
+}
+
+void OS::Trace::measure(void)
+{
+    CriticalSection section; // Nothing else records while measuring, so the ring head can be restored.
+    bool recording = m_recording.exchange(true);
+    uint32_t head = m_head.load();
+    uint32_t t0 = timestamp();
+    for (uint32_t i = 0; i < samples; ++i) record(TraceRecord::mark);
+    uint32_t t1 = timestamp();
+    m_head.store(head);
+    m_recording.store(recording);
+    uint32_t cost = (t1 - t0) / samples;
+    m_overhead = cost ? cost : 1;
+}
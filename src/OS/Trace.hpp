@@ -0,0 +1,131 @@
+/**
+ * @file        Trace.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Scheduler trace recorder storing binary event records in a static ring. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "hal_mcu.h"
+#include "RTOS.hpp"
+#include "StaticClass.hpp"
+#include "TraceRecord.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef WTK_TRACE_RECORDS
+#define WTK_TRACE_RECORDS 0
+#endif
+
+#if WTK_TRACE_RECORDS
+
+/// @brief Records a trace event if the recorder is compiled in. Arguments: event, [argument], [data].
+#define WTK_TRACE(...) OS::Trace::record(__VA_ARGS__)
+
+/// @brief Records a trace event with an object address as the argument if the recorder is compiled in.
+#define WTK_TRACE_OBJECT(event, object, ...) OS::Trace::record(event, OS::Trace::address(object), ##__VA_ARGS__)
+
+#else
+
+#define WTK_TRACE(...) ((void)0)
+#define WTK_TRACE_OBJECT(...) ((void)0)
+
+#endif
+
+namespace OS
+{
+
+/// @brief Scheduler trace recorder storing binary event records in a static ring.
+/// @remarks Records thread switches, scheduled tasks, mutex contention, semaphore operations and ISRs.
+///          Recording is one atomic increment and 3 stores, ISR safe, the oldest records are overwritten.
+///          Timestamps are CPU cycles from the DWT cycle counter if available, system ticks otherwise.
+///          Thread switches and ISRs are recorded from the RTOS and ISR hooks, see "trace.h".
+///          Use `TraceExport` to convert a snapshot into a viewable trace.
+class Trace final
+{
+
+    STATIC(Trace)
+
+public:
+
+    static constexpr size_t records = WTK_TRACE_RECORDS ? WTK_TRACE_RECORDS : 1; // The number of records in the ring.
+    static_assert((records & (records - 1)) == 0, "WTK_TRACE_RECORDS must be a power of 2.");
+
+    /// @brief Starts recording. Measures the recording overhead on the first call. DO NOT CALL FROM ISR!
+    static void start(void);
+
+    /// @brief Stops recording. The records are preserved. ISR safe.
+    static inline void stop(void) { m_recording.store(false); }
+
+    /// @brief Discards all records. Call when stopped.
+    static void clear(void);
+
+    /// @returns True if the recorder is recording.
+    static inline bool isRecording(void) { return m_recording.load(std::memory_order_relaxed); }
+
+    /// @brief Copies the stored records, oldest first. Recording is paused while copying.
+    /// @param buffer Target buffer.
+    /// @param capacity Target buffer capacity in records. The newest records are copied if the buffer is too small.
+    /// @returns The number of records copied.
+    static size_t snapshot(TraceRecord* buffer, size_t capacity);
+
+    /// @returns The number of records overwritten since the last `clear`.
+    static inline uint32_t lost(void)
+    {
+        uint32_t head = m_head.load();
+        return head > records ? head - records : 0;
+    }
+
+    /// @returns The number of timestamp units per second.
+    static uint32_t frequency(void);
+
+    /// @returns The average cost of recording one event in timestamp units, measured by `start`.
+    static inline uint32_t overhead(void) { return m_overhead; }
+
+    /// @returns The current timestamp.
+    static inline uint32_t timestamp(void)
+    {
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+        return DWT->CYCCNT;
+#else
+        return getTick();
+#endif
+    }
+
+    /// @returns Object address as the record argument.
+    /// @param object Object pointer.
+    static inline uint32_t address(const void* object) { return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(object)); }
+
+    /// @brief Stores an event record if recording. ISR safe.
+    /// @param event Event type.
+    /// @param argument Event argument. Default: 0.
+    /// @param data Small event data. Default: 0.
+    static inline void record(TraceRecord::Event event, uint32_t argument = 0, uint16_t data = 0)
+    {
+        if (!m_recording.load(std::memory_order_relaxed)) return;
+        TraceRecord& r = m_ring[m_head.fetch_add(1, std::memory_order_relaxed) & (records - 1)];
+        r.timestamp = timestamp();
+        r.event = event;
+        r.data = data;
+        r.argument = argument;
+    }
+
+private:
+
+    /// @brief Measures the average recording cost. Overwrites up to `samples` oldest records.
+    static void measure(void);
+
+    static constexpr uint32_t samples = 16;             // The number of records used to measure the overhead.
+    static inline TraceRecord m_ring[records] = {};     // Record ring.
+    static inline std::atomic<uint32_t> m_head = 0;     // The total number of records stored since the last `clear`.
+    static inline std::atomic<bool> m_recording = false; // True if recording.
+    static inline uint32_t m_overhead = 0;              // Measured recording cost in timestamp units.
+
+};
+
+}
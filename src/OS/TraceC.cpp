@@ -0,0 +1,39 @@
+/**
+ * @file        TraceC.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Provides trace recorder C bindings for the RTOS and ISR hooks.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Trace.hpp"
+#include "trace.h"
+
+/// @returns The active exception number.
+static inline uint16_t exception(void) { return static_cast<uint16_t>(SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk); }
+
+EXTERN_C_BEGIN
+
+void trace_thread_in([[maybe_unused]] void* thread) { WTK_TRACE_OBJECT(OS::TraceRecord::threadIn, thread); }
+
+void trace_thread_out([[maybe_unused]] void* thread) { WTK_TRACE_OBJECT(OS::TraceRecord::threadOut, thread); }
+
+void trace_isr_enter(void) { WTK_TRACE(OS::TraceRecord::isrEnter, 0, exception()); }
+
+void trace_isr_exit(void) { WTK_TRACE(OS::TraceRecord::isrExit, 0, exception()); }
+
+#if defined(USE_AZURE_RTOS) && defined(TX_ENABLE_EXECUTION_CHANGE_NOTIFY)
+
+void _tx_execution_thread_enter(void) { trace_thread_in(tx_thread_identify()); }
+
+void _tx_execution_thread_exit(void) { trace_thread_out(tx_thread_identify()); }
+
+void _tx_execution_isr_enter(void) { trace_isr_enter(); }
+
+void _tx_execution_isr_exit(void) { trace_isr_exit(); }
+
+#endif
+
+EXTERN_C_END
@@ -0,0 +1,149 @@
+/**
+ * @file        TraceExport.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Converts trace records into the Chrome trace event format, viewable in Perfetto UI or chrome://tracing. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "TraceExport.hpp"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+static constexpr uint32_t cpuTrack = 0;     // The track showing the running threads.
+static constexpr uint32_t isrTrack = 1;     // The track showing the interrupt handlers.
+static constexpr uint32_t startTrack = 2;   // The track for the events recorded before the first thread switch.
+
+/// @brief Formats the thread name.
+/// @param buffer Target buffer.
+/// @param size Target buffer size.
+/// @param names Optional thread name resolver.
+/// @param thread Thread handle.
+/// @returns Target buffer pointer.
+static const char* threadName(char* buffer, size_t size, OS::TraceExport::NameResolver names, uint32_t thread)
+{
+    const char* name = names ? names(thread) : nullptr;
+    if (name) snprintf(buffer, size, "%s", name);
+    else snprintf(buffer, size, "0x%08lx", static_cast<unsigned long>(thread));
+    return buffer;
+}
+
+void OS::TraceExport::chrome(const TraceRecord* records, size_t count, uint32_t frequency, Writer writer, void* context, NameResolver names)
+{
+    if (!writer) return;
+    static constexpr char header[] = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    static constexpr char footer[] = "\n]}\n";
+    Output output { writer, context, true };
+    writer(context, header, sizeof(header) - 1);
+    event(output, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"CPU\"}}", static_cast<unsigned long>(cpuTrack));
+    event(output, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"ISR\"}}", static_cast<unsigned long>(isrTrack));
+    event(output, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"Startup\"}}", static_cast<unsigned long>(startTrack));
+    uint32_t named[maxNamedThreads] = {};
+    size_t namedCount = 0;
+    char name[32];
+    double scale = frequency ? 1e6 / frequency : 1.0; // Timestamp units to microseconds.
+    uint64_t elapsed = 0;           // Unwrapped timestamp since the first record.
+    uint32_t previous = count ? records[0].timestamp : 0;
+    uint32_t thread = startTrack;   // The track of the running thread.
+    bool running = false;           // True if the running thread was switched in.
+    double runStart = 0;            // The time the running thread was switched in.
+    uint32_t isrDepth = 0;          // The number of nested interrupt handlers.
+    for (size_t i = 0; i < count; ++i)
+    {
+        const TraceRecord& r = records[i];
+        elapsed += static_cast<uint32_t>(r.timestamp - previous);
+        previous = r.timestamp;
+        double ts = elapsed * scale;
+        unsigned long argument = r.argument;
+        uint32_t track = isrDepth ? isrTrack : thread;
+        switch (r.event)
+        {
+        case TraceRecord::threadIn:
+            if (running)
+                event(output, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                    threadName(name, sizeof(name), names, thread), static_cast<unsigned long>(cpuTrack), runStart, ts - runStart);
+            if (std::find(named, named + namedCount, r.argument) == named + namedCount && namedCount < maxNamedThreads)
+            {
+                named[namedCount++] = r.argument;
+                event(output, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+                    argument, threadName(name, sizeof(name), names, r.argument));
+            }
+            thread = r.argument;
+            running = true;
+            runStart = ts;
+            break;
+        case TraceRecord::threadOut:
+            if (!running || thread != r.argument) break;
+            event(output, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                threadName(name, sizeof(name), names, thread), static_cast<unsigned long>(cpuTrack), runStart, ts - runStart);
+            running = false;
+            break;
+        case TraceRecord::taskEnqueue:
+            event(output, "{\"name\":\"enqueue %lu\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"args\":{\"context\":%u}}",
+                argument, static_cast<unsigned long>(track), ts, static_cast<unsigned>(r.data));
+            break;
+        case TraceRecord::taskBegin:
+            event(output, "{\"name\":\"task %lu\",\"ph\":\"B\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"args\":{\"context\":%u}}",
+                argument, static_cast<unsigned long>(track), ts, static_cast<unsigned>(r.data));
+            break;
+        case TraceRecord::taskEnd:
+        case TraceRecord::mutexAcquired:
+        case TraceRecord::semaphoreTaken:
+            event(output, "{\"ph\":\"E\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"args\":{\"result\":%u}}",
+                static_cast<unsigned long>(track), ts, static_cast<unsigned>(r.data));
+            break;
+        case TraceRecord::mutexWait:
+            event(output, "{\"name\":\"mutex 0x%08lx\",\"ph\":\"B\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}",
+                argument, static_cast<unsigned long>(track), ts);
+            break;
+        case TraceRecord::semaphoreWait:
+            event(output, "{\"name\":\"semaphore 0x%08lx\",\"ph\":\"B\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}",
+                argument, static_cast<unsigned long>(track), ts);
+            break;
+        case TraceRecord::semaphoreGive:
+            event(output, "{\"name\":\"give 0x%08lx\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}",
+                argument, static_cast<unsigned long>(track), ts);
+            break;
+        case TraceRecord::isrEnter:
+            ++isrDepth;
+            event(output, "{\"name\":\"exception %u\",\"ph\":\"B\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}",
+                static_cast<unsigned>(r.data), static_cast<unsigned long>(isrTrack), ts);
+            break;
+        case TraceRecord::isrExit:
+            if (!isrDepth) break; // The handler entry was overwritten.
+            --isrDepth;
+            event(output, "{\"ph\":\"E\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}", static_cast<unsigned long>(isrTrack), ts);
+            break;
+        case TraceRecord::mark:
+            event(output, "{\"name\":\"mark %u\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"args\":{\"argument\":%lu}}",
+                static_cast<unsigned>(r.data), static_cast<unsigned long>(track), ts, argument);
+            break;
+        default:
+            break;
+        }
+    }
+    if (running)
+        event(output, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+            threadName(name, sizeof(name), names, thread), static_cast<unsigned long>(cpuTrack), runStart, elapsed * scale - runStart);
+    writer(context, footer, sizeof(footer) - 1);
+}
+
+void OS::TraceExport::event(Output& output, const char* format, ...)
+{
+    char buffer[192];
+    buffer[0] = ',';
+    buffer[1] = '\n';
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer + 2, sizeof(buffer) - 2, format, args);
+    va_end(args);
+    if (length < 0) return;
+    size_t total = static_cast<size_t>(length) + 2;
+    if (total > sizeof(buffer) - 1) total = sizeof(buffer) - 1;
+    size_t skip = output.first ? 2 : 0;
+    output.first = false;
+    output.writer(output.context, buffer + skip, total - skip);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file        TraceExport.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Converts trace records into the Chrome trace event format, viewable in Perfetto UI or chrome://tracing. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @remarks     Has no target dependencies, so it can also be built on a host to convert a ring dumped from the target RAM.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "StaticClass.hpp"
+#include "TraceRecord.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace OS
+{
+
+/// @brief Converts trace records into the Chrome trace event format (JSON), viewable in Perfetto UI or chrome://tracing.
+/// @remarks The "CPU" track shows which thread runs, the "ISR" track shows interrupt handlers.
+///          Each thread has its own track with scheduled actions, mutex and semaphore waits as slices,
+///          enqueued tasks and semaphore releases as instant events.
+class TraceExport final
+{
+
+    STATIC(TraceExport)
+
+public:
+
+    /// @brief Output function receiving consecutive parts of the JSON text.
+    using Writer = void(*)(void* context, const char* text, size_t length);
+
+    /// @brief Returns the name of a thread by its handle, or `nullptr` if not known.
+    using NameResolver = const char*(*)(uint32_t thread);
+
+    /// @brief Writes the records as a Chrome trace JSON document.
+    /// @param records Records, oldest first, as returned by `Trace::snapshot`.
+    /// @param count The number of records.
+    /// @param frequency The number of timestamp units per second, as returned by `Trace::frequency`.
+    /// @param writer Output function.
+    /// @param context Output function context. Default: `nullptr`.
+    /// @param names Optional thread name resolver. Threads are named by their handles if not set.
+    static void chrome(const TraceRecord* records, size_t count, uint32_t frequency, Writer writer, void* context = nullptr, NameResolver names = nullptr);
+
+private:
+
+    static constexpr size_t maxNamedThreads = 32; // The maximal number of threads named in one document.
+
+    /// @brief Output state.
+    struct Output
+    {
+        Writer writer;          // Output function.
+        void* context;          // Output function context.
+        bool first;             // True until the first event is written.
+    };
+
+    /// @brief Writes a formatted event, separated from the previous one.
+    /// @param output Output state.
+    /// @param format Event format string.
+    /// @param ... Format arguments.
+    static void event(Output& output, const char* format, ...);
+
+};
+
+}
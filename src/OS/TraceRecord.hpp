@@ -0,0 +1,53 @@
+/**
+ * @file        TraceRecord.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Binary trace record stored by the trace recorder. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @remarks     Has no target dependencies, so the records can be decoded by the same code on a host.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace OS
+{
+
+/// @brief Binary trace record, 12 bytes.
+struct TraceRecord
+{
+
+    /// @brief Recorded event type.
+    enum Event : uint8_t
+    {
+        empty,          // Unused record.
+        threadIn,       // A thread is switched in. Argument: thread handle.
+        threadOut,      // A thread is switched out. Argument: thread handle.
+        taskEnqueue,    // A task is scheduled. Argument: task identifier, data: thread context.
+        taskBegin,      // A scheduled action starts. Argument: task identifier, data: thread context.
+        taskEnd,        // A scheduled action returns. Argument: task identifier, data: thread context.
+        mutexWait,      // A thread blocks on a taken mutex. Argument: mutex address.
+        mutexAcquired,  // A blocked mutex wait ends. Argument: mutex address, data: 1 if acquired, 0 on timeout.
+        semaphoreWait,  // A thread starts waiting for a semaphore. Argument: semaphore address.
+        semaphoreTaken, // A semaphore wait ends. Argument: semaphore address, data: 1 if taken, 0 on timeout.
+        semaphoreGive,  // A semaphore is released. Argument: semaphore address.
+        isrEnter,       // An interrupt handler starts. Data: exception number.
+        isrExit,        // An interrupt handler returns. Data: exception number.
+        mark            // User mark. Argument and data are user defined.
+    };
+
+    uint32_t timestamp; // Timestamp in `Trace::frequency` units.
+    Event event;        // Event type.
+    uint8_t reserved;   // Padding, zero.
+    uint16_t data;      // Small event data.
+    uint32_t argument;  // Event argument.
+
+};
+
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord must be 12 bytes.");
+
+}
@@ -0,0 +1,130 @@
+/**
+ * @file        Watchdog.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Software watchdog detecting stalled threads and long running scheduled actions. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Watchdog.hpp"
+#include "Crash.hpp"
+#include "CurrentThread.hpp"
+#include "Log.hpp"
+#include "Task.hpp"
+#include "main.h"
+#include <cstdio>
+
+#if defined(COUNTER_TIM) && defined(COUNTER_1S)
+#include "Counter.hpp"
+#define WATCHDOG_COUNTER
+#endif
+
+void OS::Watchdog::start(TickCount interval, bool crashOnStall)
+{
+    if (CurrentThread::isISRContext() || m_thread.active() || !interval) Crash::here();
+    m_interval = interval;
+    m_crashOnStall = crashOnStall;
+    m_thread.start(monitorEntry, "Watchdog", ThreadPriority::high);
+}
+
+OS::Watchdog::Handle OS::Watchdog::watch(const char* name, TickCount limit)
+{
+    return add(name, none, limit);
+}
+
+OS::Watchdog::Handle OS::Watchdog::watch(const char* name, ThreadContext context, TickCount limit)
+{
+    if (context == none) return invalid;
+    return add(name, context, limit);
+}
+
+void OS::Watchdog::unwatch(Handle& handle)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    if (handle >= maxEntries) return;
+    m_entries[handle].name = nullptr;
+    handle = invalid;
+}
+
+OS::Watchdog::Handle OS::Watchdog::add(const char* name, ThreadContext context, TickCount limit)
+{
+    if (CurrentThread::isISRContext()) Crash::here();
+    if (!name || !limit) return invalid;
+    for (Handle i = 0; i < maxEntries; ++i)
+    {
+        Entry& entry = m_entries[i];
+        if (entry.name) continue;
+        entry.limit = limit;
+        entry.lastCheckIn = getTick();
+        entry.context = context;
+        entry.stalledTask = 0;
+        entry.isStalled = false;
+        entry.name = name; // Set last, the monitor skips entries without the name.
+        return i;
+    }
+    return invalid;
+}
+
+void OS::Watchdog::scan(void)
+{
+#if defined(WATCHDOG_COUNTER)
+    uint32_t t0 = Counter::getTicks();
+#endif
+    TickCount now = getTick();
+    for (auto& entry : m_entries) if (entry.name) check(entry, now);
+    ++m_statistics.scans;
+#if defined(WATCHDOG_COUNTER)
+    m_statistics.lastScanTicks = Counter::getTicks() - t0;
+    if (m_statistics.lastScanTicks > m_statistics.maxScanTicks) m_statistics.maxScanTicks = m_statistics.lastScanTicks;
+#endif
+}
+
+void OS::Watchdog::check(Entry& entry, TickCount now)
+{
+    static char message[128];
+    bool isStalled;
+    TickCount elapsed;
+    RunningAction running {};
+    if (entry.context == none)
+    {
+        elapsed = now - entry.lastCheckIn;
+        isStalled = elapsed > entry.limit;
+    }
+    else
+    {
+        running = Task::running(entry.context);
+        elapsed = running.id ? now - running.since : 0;
+        isStalled = running.id && elapsed > entry.limit;
+        if (isStalled && entry.isStalled && running.id != entry.stalledTask) entry.isStalled = false; // Another action stalls now.
+    }
+    if (isStalled == entry.isStalled) return;
+    entry.isStalled = isStalled;
+    if (!isStalled)
+    {
+        Log::msg(LogMessage::warning, "Watchdog: %s recovered.", entry.name);
+        return;
+    }
+    ++m_statistics.stalls;
+    entry.stalledTask = running.id;
+    if (entry.context == none)
+        snprintf(message, sizeof(message), "Watchdog: %s stalled, no check-in for %lu ticks.",
+            entry.name, static_cast<unsigned long>(elapsed));
+    else
+        snprintf(message, sizeof(message), "Watchdog: %s stalled, task %lu action %p (%p) running for %lu ticks.",
+            entry.name, static_cast<unsigned long>(running.id), reinterpret_cast<void*>(running.action.plain), running.binding,
+            static_cast<unsigned long>(elapsed));
+    Log::msg(LogMessage::error, "%s", message);
+    if (m_crashOnStall) Crash::withMessage(message);
+}
+
+void OS::Watchdog::monitorEntry(ThreadArg)
+{
+    TickCount release = getTick();
+    for (;;)
+    {
+        delayUntil(release, m_interval);
+        scan();
+    }
+}
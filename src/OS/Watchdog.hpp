@@ -0,0 +1,120 @@
+/**
+ * @file        Watchdog.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Software watchdog detecting stalled threads and long running scheduled actions. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "StaticClass.hpp"
+#include "Thread.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#ifndef WTK_OS_WATCHDOG_ENTRIES
+#define WTK_OS_WATCHDOG_ENTRIES 8
+#endif
+
+namespace OS
+{
+
+/// @brief Software watchdog detecting stalled threads and long running scheduled actions.
+/// @remarks Watched threads call `checkIn` with their handle at least once per their limit.
+///          Watched scheduler contexts are checked for an action that runs longer than the limit, no check-ins needed.
+///          The monitor thread scans all entries once per interval. A stall is logged once, with the action running in the context,
+///          and optionally halts the application with `Crash::withMessage`, leaving the entry name for the debugger.
+///          The monitor runs with the `high` priority, so it also reports the threads starved by a busy higher priority thread below it.
+class Watchdog final
+{
+
+    STATIC(Watchdog)
+
+public:
+
+    using Handle = uint32_t;                            // Watched entry handle.
+    static constexpr Handle invalid = 0xFFFFFFFFul;     // Not a valid handle.
+    static constexpr size_t maxEntries = WTK_OS_WATCHDOG_ENTRIES; // The maximal number of watched entries.
+
+    /// @brief Monitor statistics.
+    struct Statistics
+    {
+        uint32_t scans;         // The number of completed scans.
+        uint32_t stalls;        // The number of detected stalls.
+        uint32_t lastScanTicks; // The duration of the last scan in `Counter` ticks, zero if the `Counter` is not available.
+        uint32_t maxScanTicks;  // The longest scan duration in `Counter` ticks, zero if the `Counter` is not available.
+    };
+
+    /// @brief Starts the monitor thread. DO NOT CALL FROM ISR!
+    /// @param interval The number of system ticks between scans.
+    /// @param crashOnStall True to halt the application on the first stall detected. Default: false.
+    static void start(TickCount interval, bool crashOnStall = false);
+
+    /// @brief Adds a thread that checks in. DO NOT CALL FROM ISR!
+    /// @param name Entry name used in the stall messages. The string must outlive the entry.
+    /// @param limit The maximal number of system ticks between check-ins.
+    /// @returns A handle to check in with, or `invalid` if all entries are used.
+    static Handle watch(const char* name, TickCount limit);
+
+    /// @brief Adds a scheduler thread context, where a single action must not run longer than the limit. DO NOT CALL FROM ISR!
+    /// @param name Entry name used in the stall messages. The string must outlive the entry.
+    /// @param context Thread context, `application` or `frame`.
+    /// @param limit The maximal number of system ticks a single scheduled action can run.
+    /// @returns An entry handle, or `invalid` if all entries are used.
+    static Handle watch(const char* name, ThreadContext context, TickCount limit);
+
+    /// @brief Removes the entry. DO NOT CALL FROM ISR!
+    /// @param handle Entry handle. Set to `invalid`.
+    static void unwatch(Handle& handle);
+
+    /// @brief Reports the watched thread is alive. A single store, ISR safe.
+    /// @param handle Entry handle.
+    static inline void checkIn(Handle handle)
+    {
+        if (handle < maxEntries) m_entries[handle].lastCheckIn = getTick();
+    }
+
+    /// @returns True if the entry is currently reported as stalled.
+    /// @param handle Entry handle.
+    static inline bool isStalled(Handle handle) { return handle < maxEntries && m_entries[handle].isStalled; }
+
+    /// @returns A copy of the monitor statistics.
+    static inline Statistics statistics() { return m_statistics; }
+
+private:
+
+    /// @brief Watched entry.
+    struct Entry
+    {
+        const char* name;                   // Entry name, `nullptr` for a free entry.
+        TickCount limit;                    // The maximal number of system ticks between check-ins, or of a single action.
+        volatile TickCount lastCheckIn;     // The system tick of the last check-in.
+        ThreadContext context;              // Watched scheduler context, `none` for a thread that checks in.
+        TaskId stalledTask;                 // The identifier of the task reported as stalled.
+        volatile bool isStalled;            // True if reported as stalled.
+    };
+
+    /// @brief Adds an entry.
+    static Handle add(const char* name, ThreadContext context, TickCount limit);
+
+    /// @brief Checks all entries.
+    static void scan(void);
+
+    /// @brief Checks one entry, logs a new stall or a recovery.
+    static void check(Entry& entry, TickCount now);
+
+    /// @brief Monitor thread loop.
+    static void monitorEntry(ThreadArg arg);
+
+    static inline Entry m_entries[maxEntries] = {};     // Watched entries.
+    static inline Thread m_thread = {};                 // Monitor thread.
+    static inline TickCount m_interval = 0;             // The number of system ticks between scans.
+    static inline bool m_crashOnStall = false;          // True to halt the application on a stall.
+    static inline Statistics m_statistics = {};         // Monitor statistics.
+
+};
+
+}
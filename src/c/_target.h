@@ -21,14 +21,46 @@
 
 #define USE_FREE_RTOS                               // Use FreeRTOS as the Real Time Operationg System.
 #define USE_FATFS                                   // Use FATFS as the file system access backend.
+// #define USE_POSIX                                   // Use the host POSIX file API as the file system access backend (workstation builds).
+// #define USE_RAMFS                                   // Use the RAM disk as the file system access backend.
+// #define USE_DISK_IMAGE                              // Provide the `FS::DiskImage` FATFS driver for the host disk image files (workstation builds).
 
 // FOLLOWING VALUES AFFECT BOTH SYSTEM PERFORMANCE AND MEMORY REQUIREMENTS:
 
 #define WTK_ASYNC_RESULTS       32                  // The number of pre-allocated asynchronous operation result handles, default 32.
+#define WTK_EVENT_SUBSCRIBERS   32                  // The number of `OS::EventBus` subscriber table entries, default 32.
+#define WTK_EVENT_QUEUE         32                  // The number of deferred `OS::EventBus` events per thread context, default 32.
+#define WTK_EVENT_PAYLOAD       16                  // The maximal `OS::EventBus` event payload size in bytes, default 16.
+#define WTK_FS_ADAPTER_DISPATCH 0                   // 1: Call the adapter set for each mounted file system (`FS::AdapterProxy` layers), 0: the compiled in adapter only, default 0.
+#define WTK_FS_BLOCK_CACHE      0                   // The number of `FS::BlockCache` FATFS sector buffers, 0 disables the cache, default 0.
+#define WTK_FS_BLOCK_CACHE_DRIVERS 2                // The maximal number of FATFS disk I/O drivers wrapped by `FS::BlockCache`, default 2.
+#define WTK_FS_FILE_BUFFERS     2                   // The number of pooled `FS::File` write-back buffers, default 2.
+#define WTK_FS_FILE_BUFFER_SIZE 4096                // The pooled `FS::File` write-back buffer size in bytes, default 4096.
+#define WTK_FS_IO_INFLIGHT      1                   // The maximal number of `FS::IOService` operations executed at once per media, default 1.
+#define WTK_FS_IO_REQUESTS      8                   // The maximal number of undelivered `FS::IOService` requests, default 8.
+#define WTK_FS_IO_SCHEDULER     0                   // The number of concurrent `FS::File` transfers ordered by `FS::IOScheduler` (max 24), 0 disables it, default 0.
+#define WTK_FS_IO_SCHEDULER_AGING 4                 // The number of times `FS::IOScheduler` can pass a waiting transfer over, default 4.
+#define WTK_FS_IO_WORKERS       1                   // The number of `FS::IOService` worker threads (each is an `OS::Thread`), default 1.
+#define WTK_FS_POSIX_LATENCY    0                   // Simulated `FS::AdapterPOSIX` media latency in microseconds per read or write, default 0.
+#define WTK_FS_RECORD_LOG_COMMIT_MS 100             // The default `FS::RecordLog` group commit interval in milliseconds, default 100.
+#define WTK_FS_STAT_CACHE       0                   // The number of paths in the `FS::StatCache` metadata cache, 0 disables the cache, default 0.
+#define WTK_FS_STREAMS          4                   // The maximal number of queued `FS::StreamReader` read-ahead requests, default 4.
 #define WTK_LOG_Q               64                  // The number of log messages that can be stored in RAM before the first one is committed.
 #define WTK_LOG_MSG_SIZE        128                 // The number of bytes allocated for 1 system log message.
 #define WTK_OS_TASKS            16                  // The number of pre-allocated scheduled tasks, default 16.
 #define WTK_OS_THREAD_STACK     4096                // The number of bytes allocated for `OS::Thread` instance stack.
+#define WTK_OS_PARALLEL_WORKERS 1                   // The number of `OS::parallelFor` worker threads (each is an `OS::Thread`), default 1.
+#define WTK_OS_PERIODIC_THREADS 8                   // The maximal number of started `OS::PeriodicThread` instances, default 8.
+#define WTK_OS_PERIODIC_BINS    8                   // The number of `OS::PeriodicThread` statistics histogram bins, default 8.
+#define WTK_OS_WATCHDOG_ENTRIES 8                   // The maximal number of `OS::Watchdog` watched threads and contexts, default 8.
+#define WTK_OS_TLS_THREADS      16                  // The maximal number of threads having own `OS::ThreadLocal` values, default 16.
+#define WTK_OS_TLS_INDEX        0                   // FreeRTOS thread local storage pointer index used by `OS::ThreadLocal`, default 0.
+#define WTK_RAMFS_BLOCK_SIZE    512                 // The `FS::AdapterRAM` block size in bytes, default 512.
+#define WTK_RAMFS_BLOCKS        256                 // The number of `FS::AdapterRAM` blocks per volume, default 256.
+#define WTK_RAMFS_ENTRIES       32                  // The number of `FS::AdapterRAM` files and directories per volume, default 32.
+#define WTK_RAMFS_EXTENTS       8                   // The maximal number of `FS::AdapterRAM` block runs per file, default 8.
+#define WTK_RAMFS_NAME          64                  // The maximal `FS::AdapterRAM` path length including the terminator, default 64.
+#define WTK_TRACE_RECORDS       0                   // The number of `OS::Trace` ring records (a power of 2, 12 bytes each), 0 disables tracing, default 0.
 
 // SET EXACTLY AS IN THE TARGET RTOS CONFIGURATION:
 
@@ -25,7 +25,7 @@ typedef struct __FS_Placeholder
 /// @brief Physical media type.
 typedef enum
 {
-    FS_MEDIA_NONE, FS_MEDIA_eMMC, FS_MEDIA_SD, FS_MEDIA_USB
+    FS_MEDIA_NONE, FS_MEDIA_eMMC, FS_MEDIA_SD, FS_MEDIA_USB, FS_MEDIA_RAM
 } FS_MediaType;
 
 /// @brief Media format enumeration.
@@ -44,11 +44,20 @@ typedef char FS_MediaRoot[4]; // Media root path.
 
 #include "fx_api.h"
 
+/// @brief FILEX directory enumeration state.
+typedef struct __FS_FilexDirectory
+{
+    FX_MEDIA* media;        // Media pointer, null if the handle is not used.
+    FX_LOCAL_PATH path;     // Local path set to the enumerated directory, holds the search position.
+    UINT isStarted;         // 1: The first entry was read. 0: The next read returns the first entry.
+} FS_FilexDirectory;
+
 typedef VOID (*FS_MediaDriver)(FX_MEDIA*);
 typedef VOID*           FS_MediaDriverInfo;
 typedef FX_MEDIA        FS_Media;
 typedef FX_DIR_ENTRY    FS_DirectoryEntry;
 typedef FX_FILE         FS_FileControlBlock;
+typedef FS_FilexDirectory FS_DirectoryHandle;
 typedef ULONG           FS_FileOffset;
 typedef UINT            FS_Status;
 
@@ -61,10 +70,130 @@ typedef FATFS                               FS_Media;
 
 typedef struct { DIR dir; FILINFO info; }   FS_DirectoryEntry;
 typedef FIL                                 FS_FileControlBlock;
+typedef DIR                                 FS_DirectoryHandle;
 
 typedef FSIZE_t                             FS_FileOffset;
 typedef FRESULT                             FS_Status;
 
+#elif defined(USE_POSIX)
+
+// `AdapterPOSIX` types:
+
+#include <dirent.h>
+#include <stdint.h>
+
+/// @brief Host directory entry.
+typedef struct __FS_PosixDirectoryEntry
+{
+    char name[256];     // Entry name.
+    uint64_t size;      // File size in bytes.
+    int64_t modified;   // Last modification time as `time_t`.
+    int isDirectory;    // 1: The entry is a directory. 0: The entry is a file.
+} FS_PosixDirectoryEntry;
+
+/// @brief Host file handle.
+typedef struct __FS_PosixFile
+{
+    int isUsed;         // 1: The file is open. 0: The structure is reset.
+    int descriptor;     // File descriptor.
+    uint64_t offset;    // Read / write pointer, used for `pread` and `pwrite`.
+} FS_PosixFile;
+
+/// @brief Host directory enumeration handle.
+typedef struct __FS_PosixDirectory
+{
+    DIR* stream;        // Host directory stream, null if the handle is not used.
+} FS_PosixDirectory;
+
+typedef const char*             FS_MediaDriver;     // Host directory the media root is mapped onto.
+typedef void*                   FS_MediaDriverInfo;
+typedef FS_Placeholder          FS_Media;
+typedef FS_PosixDirectoryEntry  FS_DirectoryEntry;
+typedef FS_PosixFile            FS_FileControlBlock;
+typedef FS_PosixDirectory       FS_DirectoryHandle;
+typedef uint64_t                FS_FileOffset;
+typedef int                     FS_Status;          // `errno` value, 0 on success.
+
+#elif defined(USE_RAMFS)
+
+// `AdapterRAM` types:
+
+#include <stdint.h>
+
+#ifndef WTK_RAMFS_BLOCK_SIZE
+#define WTK_RAMFS_BLOCK_SIZE 512
+#endif
+
+#ifndef WTK_RAMFS_BLOCKS
+#define WTK_RAMFS_BLOCKS 256
+#endif
+
+#ifndef WTK_RAMFS_ENTRIES
+#define WTK_RAMFS_ENTRIES 32
+#endif
+
+#ifndef WTK_RAMFS_EXTENTS
+#define WTK_RAMFS_EXTENTS 8
+#endif
+
+#ifndef WTK_RAMFS_NAME
+#define WTK_RAMFS_NAME 64
+#endif
+
+/// @brief A run of consecutive blocks.
+typedef struct __FS_RamExtent
+{
+    uint32_t first;     // The first block index.
+    uint32_t count;     // The number of blocks.
+} FS_RamExtent;
+
+/// @brief RAM disk directory table entry.
+typedef struct __FS_RamEntry
+{
+    char name[WTK_RAMFS_NAME];                  // Path relative to the volume root, empty if the entry is not used.
+    uint32_t size;                              // File size in bytes.
+    uint8_t isDirectory;                        // 1: The entry is a directory. 0: The entry is a file.
+    uint8_t openCount;                          // The number of open handles.
+    uint8_t extentCount;                        // The number of used extents.
+    FS_RamExtent extents[WTK_RAMFS_EXTENTS];    // File data extents, in file order.
+} FS_RamEntry;
+
+/// @brief RAM disk volume, all zeros is an empty formatted volume. Can be placed in any RAM section.
+typedef struct __FS_RamVolume
+{
+    FS_RamEntry entries[WTK_RAMFS_ENTRIES];                 // Directory table.
+    uint32_t freeHint;                                      // The lowest block index that can be free.
+    uint32_t usedCount;                                     // The number of used blocks.
+    uint8_t map[(WTK_RAMFS_BLOCKS + 7) / 8];                // Block allocation bitmap, 1 for used blocks.
+    uint8_t blocks[WTK_RAMFS_BLOCKS][WTK_RAMFS_BLOCK_SIZE]; // Data blocks.
+} FS_RamVolume;
+
+/// @brief RAM disk file handle.
+typedef struct __FS_RamFile
+{
+    FS_RamVolume* volume;   // Volume pointer, null if the handle is not used.
+    uint32_t entry;         // Directory table entry index.
+    uint32_t offset;        // Read / write pointer.
+    uint32_t mode;          // `FileMode` flags.
+} FS_RamFile;
+
+/// @brief RAM disk directory enumeration handle.
+typedef struct __FS_RamDirectory
+{
+    FS_RamVolume* volume;       // Volume pointer, null if the handle is not used.
+    uint32_t next;              // The next directory table index to test.
+    char path[WTK_RAMFS_NAME];  // Enumerated directory path relative to the volume root, empty for the root directory.
+} FS_RamDirectory;
+
+typedef void*           FS_MediaDriver;
+typedef void*           FS_MediaDriverInfo;
+typedef FS_RamVolume    FS_Media;
+typedef FS_RamEntry     FS_DirectoryEntry;
+typedef FS_RamFile      FS_FileControlBlock;
+typedef FS_RamDirectory FS_DirectoryHandle;
+typedef uint32_t        FS_FileOffset;
+typedef int             FS_Status;
+
 #else
 
 // `NullAdapter` types:
@@ -74,6 +203,7 @@ typedef void*           FS_MediaDriverInfo;
 typedef FS_Placeholder  FS_Media;
 typedef FS_Placeholder  FS_DirectoryEntry;
 typedef FS_Placeholder  FS_FileControlBlock;
+typedef FS_Placeholder  FS_DirectoryHandle;
 typedef size_t          FS_FileOffset;
 typedef int             FS_Status;
 
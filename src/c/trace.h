@@ -0,0 +1,37 @@
+/**
+ * @file        trace.h
+ * @author      Adam Łyskawa
+ *
+ * @brief       Trace recorder C bindings for the RTOS and ISR hooks. Header file.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @remarks     FreeRTOS: include this file in "FreeRTOSConfig.h" and add:
+ *              #define traceTASK_SWITCHED_IN() trace_thread_in(pxCurrentTCB)
+ *              #define traceTASK_SWITCHED_OUT() trace_thread_out(pxCurrentTCB)
+ *              ThreadX: define TX_ENABLE_EXECUTION_CHANGE_NOTIFY, the hooks are implemented by the recorder.
+ *              ISRs: call `trace_isr_enter` and `trace_isr_exit` in the handlers to trace (FreeRTOS only).
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "bindings.h"
+
+EXTERN_C_BEGIN
+
+/// @brief Records a thread switched in.
+/// @param thread Thread handle.
+void trace_thread_in(void* thread);
+
+/// @brief Records a thread switched out.
+/// @param thread Thread handle.
+void trace_thread_out(void* thread);
+
+/// @brief Records an interrupt handler entry.
+void trace_isr_enter(void);
+
+/// @brief Records an interrupt handler exit.
+void trace_isr_exit(void);
+
+EXTERN_C_END